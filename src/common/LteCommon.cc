@@ -534,21 +534,17 @@ cModule* getMacByMacNodeId(MacNodeId nodeId)
 {
     // UE might have left the simulation, return NULL in this case
     // since we do not have a MAC-Module anymore
-	int id = getBinder()->getOmnetId(nodeId);
-	if (id == 0){
-		return NULL;
-	}
-	// TODO fix for relays
-	return (getSimulation()->getModule(getBinder()->getOmnetId(nodeId))->getSubmodule("lteNic")->getSubmodule("mac"));
+    // TODO fix for relays
+    return getBinder()->getMacFromMacNodeId(nodeId);
 }
 
 cModule* getRlcByMacNodeId(MacNodeId nodeId, LteRlcType rlcType)
 {
-	cModule* module = getMacByMacNodeId(nodeId);
-	if(module == NULL){
-		return NULL;
-	}
-    return getMacByMacNodeId(nodeId)->getParentModule()->getSubmodule("rlc")->getSubmodule(rlcTypeToA(rlcType).c_str());
+    cModule* module = getBinder()->getRlcFromMacNodeId(nodeId);
+    if(module == NULL){
+        return NULL;
+    }
+    return module->getSubmodule(rlcTypeToA(rlcType).c_str());
 }
 
 LteBinder* getBinder()
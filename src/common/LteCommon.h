@@ -788,6 +788,17 @@ struct UeInfo
     LtePhyBase* phy;
 };
 
+/**
+ * Transmission performed by a UE in a TTI.
+ * Registered in the binder, used for in-cell interference computation
+ */
+struct UeTxInfo
+{
+    UeInfo* ue;                  // transmitting UE
+    MacCellId cellId;            // serving cell of the UE at transmission time
+    std::vector<bool> usedBands; // bands allocated to the UE on the MACRO antenna
+};
+
 typedef std::vector<ExtCell*> ExtCellList;
 
 /*****************
@@ -803,6 +814,7 @@ typedef std::vector<std::vector<std::vector<double> > > BlerCurves;
 typedef std::vector<Cqi> CqiVector;
 typedef std::vector<Pmi> PmiVector;
 typedef std::set<Band> BandSet;
+typedef std::vector<bool> BandBitmap; // one flag per logical band
 typedef std::set<Remote> RemoteSet;
 typedef std::map<MacNodeId, bool> ConnectedUesMap;
 typedef std::pair<int, simtime_t> PacketInfo;
@@ -902,5 +914,39 @@ void parseStringToIntArray(std::string str, int* values, int dim, int pad);
  */
 void initializeAllChannels(cModule *mod);
 
+/**
+ * Returns the index of the least significant bit set in a 64-bit mask.
+ * The mask must not be zero.
+ */
+inline unsigned int lowestSetBit(uint64_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    unsigned int i = 0;
+    while (!(mask & 1))
+    {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * Returns the number of bits set in a 64-bit mask.
+ */
+inline unsigned int countSetBits(uint64_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(mask);
+#else
+    unsigned int n = 0;
+    for (; mask != 0; mask &= mask - 1)
+        n++;
+    return n;
+#endif
+}
+
 #endif
 
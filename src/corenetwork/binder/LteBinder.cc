@@ -9,8 +9,11 @@
 
 #include "corenetwork/binder/LteBinder.h"
 #include "corenetwork/deployer/LteDeployer.h"
+#include "stack/phy/layer/LtePhyBase.h"
+#include "stack/phy/layer/LtePhyUe.h"
 #include "inet/networklayer/common/L3AddressResolver.h"
 #include <cctype>
+#include <algorithm>
 #include "corenetwork/nodes/InternetMux.h"
 
 using namespace std;
@@ -634,6 +637,21 @@ void LteBinder::unregisterNode(MacNodeId id)
     if(nodeIds_.erase(id) != 1){
         EV_ERROR << "Cannot unregister node - node id \"" << id << "\" - not found";
     }
+    if (id < nodeModules_.size())
+        nodeModules_[id] = NodeModules();
+    ueInfoMap_.erase(id);
+
+    // leave all the multicast groups of the node
+    if (id < nodeMulticastGroups_.size())
+    {
+        std::vector<bool>& nodeGroups = nodeMulticastGroups_[id];
+        for (unsigned int i = 0; i < nodeGroups.size(); i++)
+        {
+            if (nodeGroups[i])
+                removeFromMulticastGroup(id, i);
+        }
+    }
+
     std::map<IPv4Address, MacNodeId>::iterator it;
     for(it = macNodeIdToIPAddress_.begin(); it != macNodeIdToIPAddress_.end(); )
     {
@@ -676,6 +694,13 @@ MacNodeId LteBinder::registerNode(cModule *module, LteNodeType type,
 
     nodeIds_[macNodeId] = module->getId();
 
+    if (nodeModules_.size() <= macNodeId)
+        nodeModules_.resize(macNodeId + 1, NodeModules());
+    nodeModules_[macNodeId] = NodeModules();
+    nodeModules_[macNodeId].node = module;
+    // look up the NIC submodules now if they have been built already
+    getNodeModules(macNodeId);
+
     module->par("macNodeId") = macNodeId;
 
     if (type == RELAY || type == UE)
@@ -733,6 +758,8 @@ void LteBinder::initialize(int stage)
         }
         nodesConfigured_ = false;
 
+        centralizedHandoverMeasurement_ = par("centralizedHandoverMeasurement");
+
         // execute node creation and setup.
         // nodesConfiguration();
     }
@@ -787,22 +814,86 @@ MacNodeId LteBinder::getMacNodeIdFromOmnetId(OmnetId id){
 	return 0;
 }
 
-LteMacBase* LteBinder::getMacFromMacNodeId(MacNodeId id)
+NodeModules* LteBinder::getNodeModules(MacNodeId id)
 {
-    if (id == 0)
+    if (id >= nodeModules_.size() || nodeModules_[id].node == NULL)
         return NULL;
 
-    LteMacBase* mac;
-    if (macNodeIdToModule_.find(id) == macNodeIdToModule_.end())
+    NodeModules* modules = &nodeModules_[id];
+    if (!modules->resolved)
     {
-        mac = check_and_cast<LteMacBase*>(getMacByMacNodeId(id));
-        macNodeIdToModule_[id] = mac;
+        // relays have no lteNic: their handles stay NULL, and the lookup is not repeated.
+        // Nodes created by the deployer are registered just before being built, and
+        // are not looked up in between
+        modules->resolved = true;
+        cModule* nic = modules->node->getSubmodule("lteNic");
+        if (nic == NULL)
+            return modules;
+
+        modules->phy = check_and_cast<LtePhyBase*>(nic->getSubmodule("phy"));
+        modules->mac = check_and_cast<LteMacBase*>(nic->getSubmodule("mac"));
+        modules->rlc = nic->getSubmodule("rlc");
+        modules->pdcp = nic->getSubmodule("pdcpRrc");
+        modules->ip2lte = nic->getSubmodule("ip2lte");
+        modules->x2Manager = nic->getSubmodule("x2Manager");
+        modules->d2dModeSelection = nic->getSubmodule("d2dModeSelection");
     }
-    else
-    {
-        mac = macNodeIdToModule_[id];
-    }
-    return mac;
+    return modules;
+}
+
+LteMacBase* LteBinder::getMacFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->mac;
+}
+
+LtePhyBase* LteBinder::getPhyFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->phy;
+}
+
+LteChannelModel* LteBinder::getChannelModelFromMacNodeId(MacNodeId id)
+{
+    // the channel model is owned by the PHY module and may be replaced at runtime
+    LtePhyBase* phy = getPhyFromMacNodeId(id);
+    return (phy == NULL) ? NULL : phy->getChannelModel();
+}
+
+cModule* LteBinder::getRlcFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->rlc;
+}
+
+cModule* LteBinder::getPdcpFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->pdcp;
+}
+
+cModule* LteBinder::getIp2lteFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->ip2lte;
+}
+
+cModule* LteBinder::getX2ManagerFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->x2Manager;
+}
+
+cModule* LteBinder::getD2DModeSelectionFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->d2dModeSelection;
+}
+
+cModule* LteBinder::getNodeFromMacNodeId(MacNodeId id)
+{
+    NodeModules* modules = getNodeModules(id);
+    return (modules == NULL) ? NULL : modules->node;
 }
 
 MacNodeId LteBinder::getNextHop(MacNodeId slaveId)
@@ -884,11 +975,15 @@ void LteBinder::addD2DCapability(MacNodeId src, MacNodeId dst)
     // insert initial communication mode
     // TODO make it configurable from NED
 
+    std::map<MacNodeId, LteD2DMode>& peers = d2dPeeringMode_[src];
+    if (peers.find(dst) == peers.end())
+        numD2DPeerings_++;
+
     // enable DM only if the two endpoints are served by the same cell
     if (nextHop_[src] == nextHop_[dst])
-        d2dPeeringMode_[src][dst] = DM;
+        peers[dst] = DM;
     else
-        d2dPeeringMode_[src][dst] = IM;
+        peers[dst] = IM;
 
     EV << "LteBinder::addD2DCapability - UE " << src << " may transmit to UE " << dst << " using D2D (current mode " << ((d2dPeeringMode_[src][dst] == DM) ? "DM)" : "IM)") << endl;
 }
@@ -913,7 +1008,14 @@ LteD2DMode LteBinder::getD2DMode(MacNodeId src, MacNodeId dst)
     if (src < UE_MIN_ID || src >= macNodeIdCounter_[2] || dst < UE_MIN_ID || dst >= macNodeIdCounter_[2])
         throw cRuntimeError("LteBinder::getD2DMode - Node Id not valid. Src %d Dst %d", src, dst);
 
-    return d2dPeeringMode_[src][dst];
+    // do not insert unknown peerings into the map
+    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = d2dPeeringMode_.find(src);
+    if (it == d2dPeeringMode_.end())
+        return IM;
+    std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.find(dst);
+    if (jt == it->second.end())
+        return IM;
+    return jt->second;
 }
 
 bool LteBinder::isFrequencyReuseEnabled(MacNodeId nodeId)
@@ -936,41 +1038,173 @@ bool LteBinder::isFrequencyReuseEnabled(MacNodeId nodeId)
 }
 
 
+int LteBinder::getMulticastGroupIndex(uint32 groupId)
+{
+    if (lastMulticastGroup_ < multicastGroups_.size() && multicastGroups_[lastMulticastGroup_].id == groupId)
+        return lastMulticastGroup_;
+
+    std::pair<uint32, unsigned int> key(groupId, 0);
+    std::vector<std::pair<uint32, unsigned int> >::iterator it = std::lower_bound(multicastGroupIndex_.begin(), multicastGroupIndex_.end(), key);
+    if (it == multicastGroupIndex_.end() || it->first != groupId)
+        return -1;
+
+    lastMulticastGroup_ = it->second;
+    return it->second;
+}
+
 void LteBinder::registerMulticastGroup(MacNodeId nodeId, int32 groupId)
 {
-    if (multicastGroupMap_.find(nodeId) == multicastGroupMap_.end())
-    {
-        MulticastGroupIdSet newSet;
-        newSet.insert(groupId);
-        multicastGroupMap_[nodeId] = newSet;
-    }
-    else
+    int index = getMulticastGroupIndex(groupId);
+    if (index < 0)
     {
-        multicastGroupMap_[nodeId].insert(groupId);
+        // first node enrolled in this group
+        index = multicastGroups_.size();
+        multicastGroups_.push_back(MulticastGroup());
+        multicastGroups_.back().id = groupId;
+
+        std::pair<uint32, unsigned int> entry(groupId, index);
+        multicastGroupIndex_.insert(std::lower_bound(multicastGroupIndex_.begin(), multicastGroupIndex_.end(), entry), entry);
     }
+
+    MulticastGroup& group = multicastGroups_[index];
+    if (nodeId < group.isMember.size() && group.isMember[nodeId])
+        return;   // the node is already enrolled in the group
+
+    // group --> nodes
+    if (nodeId >= group.isMember.size())
+        group.isMember.resize(nodeId + 1, false);
+    group.isMember[nodeId] = true;
+    group.members.insert(std::lower_bound(group.members.begin(), group.members.end(), nodeId), nodeId);
+
+    // node --> groups
+    if (nodeId >= nodeMulticastGroups_.size())
+        nodeMulticastGroups_.resize(nodeId + 1);
+    std::vector<bool>& nodeGroups = nodeMulticastGroups_[nodeId];
+    if ((unsigned int)index >= nodeGroups.size())
+        nodeGroups.resize(index + 1, false);
+    nodeGroups[index] = true;
+}
+
+void LteBinder::unregisterMulticastGroup(MacNodeId nodeId, int32 groupId)
+{
+    int index = getMulticastGroupIndex(groupId);
+    if (index >= 0)
+        removeFromMulticastGroup(nodeId, index);
+}
+
+void LteBinder::removeFromMulticastGroup(MacNodeId nodeId, unsigned int index)
+{
+    MulticastGroup& group = multicastGroups_[index];
+    if (nodeId >= group.isMember.size() || !group.isMember[nodeId])
+        return;   // the node is not enrolled in the group
+
+    // group --> nodes
+    group.isMember[nodeId] = false;
+    group.members.erase(std::lower_bound(group.members.begin(), group.members.end(), nodeId));
+
+    // node --> groups
+    nodeMulticastGroups_[nodeId][index] = false;
 }
 
 bool LteBinder::isInMulticastGroup(MacNodeId nodeId, int32 groupId)
 {
-    if (multicastGroupMap_.find(nodeId) == multicastGroupMap_.end())
-        return false;   // the node is not enrolled in any group
-    if (multicastGroupMap_[nodeId].find(groupId) == multicastGroupMap_[nodeId].end())
-        return false;   // the node is not enrolled in the given group
+    int index = getMulticastGroupIndex(groupId);
+    if (index < 0)
+        return false;   // no node is enrolled in the given group
 
-    return true;
+    const std::vector<bool>& isMember = multicastGroups_[index].isMember;
+    return nodeId < isMember.size() && isMember[nodeId];
+}
+
+const std::vector<MacNodeId>* LteBinder::getMulticastGroupMembers(int32 groupId)
+{
+    int index = getMulticastGroupIndex(groupId);
+    if (index < 0)
+        return NULL;
+    return &multicastGroups_[index].members;
 }
 
 void LteBinder::updateUeInfoCellId(MacNodeId id, MacCellId newCellId)
 {
-    std::vector<UeInfo*>::iterator it = ueList_.begin();
-    for (; it != ueList_.end(); ++it)
+    std::map<MacNodeId, UeInfo*>::iterator it = ueInfoMap_.find(id);
+    if (it != ueInfoMap_.end())
+        it->second->cellId = newCellId;
+}
+
+void LteBinder::registerTransmission(MacNodeId ueId, const RbMap& rbMap)
+{
+    if (transmittersTti_[0] != NOW)
     {
-        if ((*it)->id == id)
-        {
-            (*it)->cellId = newCellId;
+        // first transmission in this TTI: the most recent list becomes the older one
+        transmitters_[1].swap(transmitters_[0]);
+        transmittersTti_[1] = transmittersTti_[0];
+        transmitters_[0].clear();
+        transmittersTti_[0] = NOW;
+    }
+
+    std::map<MacNodeId, UeInfo*>::iterator uit = ueInfoMap_.find(ueId);
+    if (uit == ueInfoMap_.end())
+        return;
+
+    std::vector<UeTxInfo>::iterator it = transmitters_[0].begin();
+    for (; it != transmitters_[0].end(); ++it)
+    {
+        if (it->ue->id == ueId)
             return;
+    }
+
+    UeTxInfo tx;
+    tx.ue = uit->second;
+    tx.cellId = uit->second->cellId;
+    tx.usedBands.resize(numBands_, false);
+
+    RbMap::const_iterator ait = rbMap.find(MACRO);
+    if (ait != rbMap.end())
+    {
+        std::map<Band, unsigned int>::const_iterator bit = ait->second.begin();
+        for (; bit != ait->second.end(); ++bit)
+        {
+            if (bit->second == 0)
+                continue;
+            if (bit->first >= tx.usedBands.size())
+                tx.usedBands.resize(bit->first + 1, false);
+            tx.usedBands[bit->first] = true;
         }
     }
+    transmitters_[0].push_back(tx);
+}
+
+const std::vector<UeTxInfo>& LteBinder::getTransmitters(simtime_t tti)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (transmittersTti_[i] == tti)
+            return transmitters_[i];
+    }
+    return noTransmitters_;
+}
+
+BandBitmap& LteBinder::updateBandOccupancy(MacNodeId cellId, Direction dir)
+{
+    std::vector<CellBandOccupancy>& cells = bandOccupancy_[(dir == DL) ? 0 : 1];
+    if (cellId >= cells.size())
+        cells.resize(cellId + 1);
+    CellBandOccupancy& cell = cells[cellId];
+
+    // the last round becomes the previous one (swap keeps the storage of both bitmaps)
+    cell.bands[1].swap(cell.bands[0]);
+    cell.valid[1] = cell.valid[0];
+    cell.valid[0] = true;
+    return cell.bands[0];
+}
+
+const BandBitmap* LteBinder::getBandOccupancy(MacNodeId cellId, Direction dir, bool previous)
+{
+    const std::vector<CellBandOccupancy>& cells = bandOccupancy_[(dir == DL) ? 0 : 1];
+    unsigned int round = previous ? 1 : 0;
+    if (cellId >= cells.size() || !cells[cellId].valid[round])
+        return NULL;
+    return &cells[cellId].bands[round];
 }
 
 void LteBinder::addUeHandoverTriggered(MacNodeId nodeId)
@@ -989,3 +1223,53 @@ void LteBinder::removeUeHandoverTriggered(MacNodeId nodeId)
 {
     ueHandoverTriggered_.erase(nodeId);
 }
+
+void LteBinder::handleMessage(cMessage *msg)
+{
+    if (msg == measurementTimer_)
+    {
+        handoverMeasurement();
+        scheduleAt(NOW + measurementInterval_, msg);
+    }
+    else
+        delete msg;
+}
+
+void LteBinder::registerHandoverMeasurementCell(LtePhyBase* phy, simtime_t interval)
+{
+    Enter_Method_Silent();
+
+    if (measurementTimer_ == NULL)
+    {
+        measurementInterval_ = interval;
+        measurementTimer_ = new cMessage("handoverMeasurement");
+        scheduleAt(NOW, measurementTimer_);
+    }
+    else if (interval != measurementInterval_)
+    {
+        throw cRuntimeError("LteBinder::registerHandoverMeasurementCell - centralized handover measurement requires the same broadcastMessageInterval for all the eNBs (%s vs %s)",
+            interval.str().c_str(), measurementInterval_.str().c_str());
+    }
+    measurementCells_.push_back(phy);
+}
+
+void LteBinder::handoverMeasurement()
+{
+    std::vector<LtePhyBase*>::iterator it = measurementCells_.begin();
+    for (; it != measurementCells_.end(); ++it)
+    {
+        // a single handover frame per cell, shared by all the UEs in range
+        LteAirFrame* frame = (*it)->createHandoverMessage();
+        UserControlInfo* lteInfo = check_and_cast<UserControlInfo*>(frame->getControlInfo());
+
+        // only the UEs within interference distance would receive the broadcast frame
+        const ChannelControl::RadioRefVector& neighbors = (*it)->getRadioNeighbors();
+        for (unsigned int i = 0; i < neighbors.size(); i++)
+        {
+            LtePhyUe* ue = dynamic_cast<LtePhyUe*>(neighbors[i]->radioModule);
+            if (ue != NULL)
+                ue->receiveHandoverMeasurement(frame, lteInfo);
+        }
+        delete frame;
+    }
+}
@@ -22,6 +22,26 @@
 
 using namespace inet;
 
+class LtePhyBase;
+class LteChannelModel;
+
+/**
+ * Typed references to the protocol modules of a registered node, so that
+ * peer modules can be reached without walking the module tree by name
+ */
+struct NodeModules
+{
+    cModule* node;      // compound module of the node (UE, eNB, relay)
+    LtePhyBase* phy;
+    LteMacBase* mac;
+    cModule* rlc;       // compound RLC module, containing the tm, um and am submodules
+    cModule* pdcp;
+    cModule* ip2lte;
+    cModule* x2Manager; // NULL for nodes without X2 (UEs)
+    cModule* d2dModeSelection; // NULL for nodes without D2D mode selection (UEs)
+    bool resolved;      // true if the submodules of the NIC have been looked up
+};
+
 /**
  * The LTE Binder module has one instance in the whole network.
  * It stores global mapping tables with OMNeT++ module IDs,
@@ -34,6 +54,7 @@ using namespace inet;
  * After this it fills the two tables:
  * - nextHop, binding each master node id with its slave
  * - nodeId, binding each node id with the module id used by Omnet.
+ * - nodeModules, binding each node id with its protocol modules
  * - dMap_, binding each master with all its slaves (used by amc)
  *
  * The binder is accessed to gather:
@@ -52,7 +73,7 @@ class LteBinder : public cSimpleModule
     unsigned int numBands_;  // number of logical bands
     std::map<IPv4Address, MacNodeId> macNodeIdToIPAddress_;
     std::map<MacNodeId, char*> macNodeIdToModuleName_;
-    std::map<MacNodeId, LteMacBase*> macNodeIdToModule_;
+    std::vector<NodeModules> nodeModules_; // MacNodeId --> protocol modules
     DeployerList deployersMap_;
     std::vector<MacNodeId> nextHop_; // MacNodeIdMaster --> MacNodeIdSlave
     std::map<int, OmnetId> nodeIds_;
@@ -66,6 +87,31 @@ class LteBinder : public cSimpleModule
     // list of all UEs. Used for inter-cell interference evaluation
     std::vector<UeInfo*> ueList_;
 
+    // UE info indexed by nodeId
+    std::map<MacNodeId, UeInfo*> ueInfoMap_;
+
+    // UEs that transmitted in the last two TTIs with a registered transmission.
+    // Used for in-cell interference evaluation
+    std::vector<UeTxInfo> transmitters_[2];
+    // TTI of each list of transmitters, transmittersTti_[0] is the most recent one
+    simtime_t transmittersTti_[2];
+    // returned when no UE transmitted in the requested TTI
+    std::vector<UeTxInfo> noTransmitters_;
+
+    // bands occupied by a cell in its last two scheduling rounds.
+    // Written by the eNB schedulers, used for frequency reuse and inter-cell interference evaluation
+    struct CellBandOccupancy
+    {
+        BandBitmap bands[2];  // bands[0] is the most recent round
+        bool valid[2];
+        CellBandOccupancy()
+        {
+            valid[0] = valid[1] = false;
+        }
+    };
+    // indexed by the MacNodeId of the cell, one table for DL and one for UL (including D2D)
+    std::vector<CellBandOccupancy> bandOccupancy_[2];
+
     MacNodeId macNodeIdCounter_[3]; // MacNodeId Counter
     DeployedUesMap dMap_; // DeployedUes --> Master Mapping
     QCIParameters QCIParam_[LTE_QCI_CLASSES];
@@ -89,27 +135,57 @@ class LteBinder : public cSimpleModule
     std::map<MacNodeId, std::map<MacNodeId, bool> > d2dPeeringCapability_;
     // determines if two D2D-capable UEs are communicating in D2D mode or Infrastructure Mode
     std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> > d2dPeeringMode_;
+    // number of entries in d2dPeeringMode_
+    unsigned int numD2DPeerings_;
 
     /*
      * Multicast support
      */
-    // register here the IDs of the multicast group where UEs participate
-    typedef std::set<uint32> MulticastGroupIdSet;
-    std::map<MacNodeId, MulticastGroupIdSet> multicastGroupMap_;
+    // nodes enrolled in a multicast group
+    struct MulticastGroup
+    {
+        uint32 id;
+        std::vector<bool> isMember;       // indexed by MacNodeId
+        std::vector<MacNodeId> members;   // sorted
+    };
+    // groups in order of creation, so that the index of a group never changes
+    std::vector<MulticastGroup> multicastGroups_;
+    // (group ID, index in multicastGroups_), sorted by group ID
+    std::vector<std::pair<uint32, unsigned int> > multicastGroupIndex_;
+    // index of the last group looked up (consecutive lookups usually refer to the same group)
+    unsigned int lastMulticastGroup_;
+    // groups of each node, indexed by MacNodeId and by the index of the group in multicastGroups_
+    std::vector<std::vector<bool> > nodeMulticastGroups_;
+
+    // returns the index of the group in multicastGroups_, -1 if no node ever enrolled in it
+    int getMulticastGroupIndex(uint32 groupId);
+    // removes the node from the group with the given index, updating both directions of the membership
+    void removeFromMulticastGroup(MacNodeId nodeId, unsigned int index);
 
     /*
      * Handover support
      */
     // store the id of the UEs that are performing handover
     std::set<MacNodeId> ueHandoverTriggered_;
+
+    // if true, handover measurements are computed by the binder (see handoverMeasurement())
+    // instead of broadcasting an air frame from each eNB
+    bool centralizedHandoverMeasurement_;
+    // eNBs taking part in centralized handover measurements
+    std::vector<LtePhyBase*> measurementCells_;
+    // interval between two measurement rounds
+    simtime_t measurementInterval_;
+    // self message starting a measurement round
+    cMessage* measurementTimer_;
+
+    // runs a measurement round: for each cell, evaluates the handover frame at all the UEs in range
+    void handoverMeasurement();
   protected:
     virtual void initialize(int stages);
 
     virtual int numInitStages() const { return INITSTAGE_LAST; }
 
-    virtual void handleMessage(cMessage *msg)
-    {
-    }
+    virtual void handleMessage(cMessage *msg);
     /**
      * Attaches the application module to a UE module.
      * At the moment only works with UDP
@@ -145,12 +221,29 @@ class LteBinder : public cSimpleModule
 
     void parseParam(cModule* module, cXMLAttributeMap attr);
 
+    /*
+     * Returns the module references of the given node, looking up the
+     * submodules of its NIC the first time.
+     * Nodes created by the deployer register before building their submodules,
+     * hence the lookup cannot always be done at registration time
+     *
+     * @param id MacNodeId of the node
+     * @return module references, NULL if the node is not registered
+     */
+    NodeModules* getNodeModules(MacNodeId id);
+
   public:
     LteBinder()
     {
         macNodeIdCounter_[0] = ENB_MIN_ID;
         macNodeIdCounter_[1] = RELAY_MIN_ID;
         macNodeIdCounter_[2] = UE_MIN_ID;
+        transmittersTti_[0] = -1;
+        transmittersTti_[1] = -1;
+        numD2DPeerings_ = 0;
+        lastMulticastGroup_ = 0;
+        centralizedHandoverMeasurement_ = false;
+        measurementTimer_ = NULL;
     }
 
     unsigned int getNumBands()
@@ -163,6 +256,7 @@ class LteBinder : public cSimpleModule
 
     virtual ~LteBinder()
     {
+        cancelAndDelete(measurementTimer_);
         while(enbList_.size() > 0){
             delete enbList_.back();
             enbList_.pop_back();
@@ -250,6 +344,78 @@ class LteBinder : public cSimpleModule
      */
     LteMacBase* getMacFromMacNodeId(MacNodeId id);
 
+    /*
+     * getPhyFromMacNodeId() returns the reference to the LtePhyBase module
+     * given the MacNodeId of a node
+     *
+     * @param id MacNodeId of the module
+     * @return LtePhyBase* of the module, NULL if the node is not registered
+     */
+    LtePhyBase* getPhyFromMacNodeId(MacNodeId id);
+
+    /*
+     * getChannelModelFromMacNodeId() returns the channel model used by
+     * the PHY module of a node
+     *
+     * @param id MacNodeId of the module
+     * @return LteChannelModel* of the module, NULL if the node is not registered
+     */
+    LteChannelModel* getChannelModelFromMacNodeId(MacNodeId id);
+
+    /*
+     * getRlcFromMacNodeId() returns the reference to the (compound) RLC
+     * module given the MacNodeId of a node
+     *
+     * @param id MacNodeId of the module
+     * @return RLC module, NULL if the node is not registered
+     */
+    cModule* getRlcFromMacNodeId(MacNodeId id);
+
+    /*
+     * getPdcpFromMacNodeId() returns the reference to the PDCP-RRC module
+     * given the MacNodeId of a node
+     *
+     * @param id MacNodeId of the module
+     * @return PDCP-RRC module, NULL if the node is not registered
+     */
+    cModule* getPdcpFromMacNodeId(MacNodeId id);
+
+    /*
+     * getIp2lteFromMacNodeId() returns the reference to the IP2lte module
+     * given the MacNodeId of a node
+     *
+     * @param id MacNodeId of the module
+     * @return IP2lte module, NULL if the node is not registered
+     */
+    cModule* getIp2lteFromMacNodeId(MacNodeId id);
+
+    /*
+     * getX2ManagerFromMacNodeId() returns the reference to the X2 manager
+     * module given the MacNodeId of an eNB
+     *
+     * @param id MacNodeId of the module
+     * @return X2 manager module, NULL if the node is not registered or has no X2 manager
+     */
+    cModule* getX2ManagerFromMacNodeId(MacNodeId id);
+
+    /*
+     * getD2DModeSelectionFromMacNodeId() returns the reference to the D2D
+     * mode selection module given the MacNodeId of an eNB
+     *
+     * @param id MacNodeId of the module
+     * @return D2D mode selection module, NULL if the node is not registered or has no such module
+     */
+    cModule* getD2DModeSelectionFromMacNodeId(MacNodeId id);
+
+    /*
+     * getNodeFromMacNodeId() returns the compound module of a node
+     * given its MacNodeId
+     *
+     * @param id MacNodeId of the node
+     * @return node module, NULL if the node is not registered
+     */
+    cModule* getNodeFromMacNodeId(MacNodeId id);
+
     /**
      * getNextHop() returns the master of
      * a given slave
@@ -354,6 +520,7 @@ class LteBinder : public cSimpleModule
     void addUeInfo(UeInfo* info)
     {
         ueList_.push_back(info);
+        ueInfoMap_[info->id] = info;
     }
 
     std::vector<UeInfo*> * getUeList()
@@ -363,6 +530,23 @@ class LteBinder : public cSimpleModule
 
     Cqi meanCqi(std::vector<Cqi> bandCqi,MacNodeId id,Direction dir);
 
+    /*
+     * Interference support
+     */
+    // registers a transmission of the UE in the current TTI, on the given RBs.
+    // Only the first transmission of the UE in a TTI is registered
+    void registerTransmission(MacNodeId ueId, const RbMap& rbMap);
+    // returns the transmissions registered in the given TTI (only the last two TTIs are kept)
+    const std::vector<UeTxInfo>& getTransmitters(simtime_t tti);
+    /*
+     * Starts a new scheduling round of the given cell: the bitmap of the last round becomes the
+     * previous one and a reference to the bitmap of the new round is returned, to be filled by
+     * the caller with the bands the cell occupies
+     */
+    BandBitmap& updateBandOccupancy(MacNodeId cellId, Direction dir);
+    // returns the bands occupied by the cell in its last (or previous) scheduling round, NULL if unknown
+    const BandBitmap* getBandOccupancy(MacNodeId cellId, Direction dir, bool previous = false);
+
     /*
      * X2 Support
      */
@@ -375,6 +559,8 @@ class LteBinder : public cSimpleModule
     void addD2DCapability(MacNodeId src, MacNodeId dst);
     bool checkD2DCapability(MacNodeId src, MacNodeId dst);
     std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >* getD2DPeeringModeMap();
+    // number of peerings in the map above, changes whenever a peering is added
+    unsigned int getNumD2DPeerings() { return numD2DPeerings_; }
     void setD2DMode(MacNodeId src, MacNodeId dst, LteD2DMode mode);
     LteD2DMode getD2DMode(MacNodeId src, MacNodeId dst);
     bool isFrequencyReuseEnabled(MacNodeId nodeId);
@@ -383,8 +569,12 @@ class LteBinder : public cSimpleModule
      */
     // add the group to the set of multicast group of nodeId
     void registerMulticastGroup(MacNodeId nodeId, int32 groupId);
+    // remove the group from the set of multicast group of nodeId
+    void unregisterMulticastGroup(MacNodeId nodeId, int32 groupId);
     // check if the node is enrolled in the group
     bool isInMulticastGroup(MacNodeId nodeId, int32 groupId);
+    // returns the nodes enrolled in the group, sorted by MacNodeId (NULL if no node ever enrolled in it)
+    const std::vector<MacNodeId>* getMulticastGroupMembers(int32 groupId);
 
     /*
      *  Handover support
@@ -393,6 +583,12 @@ class LteBinder : public cSimpleModule
     bool hasUeHandoverTriggered(MacNodeId nodeId);
     void removeUeHandoverTriggered(MacNodeId nodeId);
     void updateUeInfoCellId(MacNodeId nodeId, MacCellId cellId);
+    bool isHandoverMeasurementCentralized() { return centralizedHandoverMeasurement_; }
+    /*
+     * Registers an eNB for centralized handover measurements, performed every interval
+     * (all the eNBs must use the same interval)
+     */
+    void registerHandoverMeasurementCell(LtePhyBase* phy, simtime_t interval);
 };
 
 #endif
@@ -26,6 +26,11 @@ using namespace std;
 
 Define_Module(IP2lte);
 
+IP2lte::IP2lte()
+{
+    hoForwardingTimer_ = NULL;
+}
+
 void IP2lte::initialize(int stage)
 {
     if (stage == inet::INITSTAGE_LOCAL)
@@ -37,8 +42,24 @@ void IP2lte::initialize(int stage)
 
         seqNum_ = 0;
 
+        flowIdleTimeout_ = par("flowIdleTimeout");
+        if (flowIdleTimeout_ <= 0)
+            throw cRuntimeError("IP2lte::initialize - flowIdleTimeout must be positive");
+        lastFlowPurge_ = 0;
+        flowSlots_.assign(FLOW_TABLE_SIZE, EMPTY_FLOW_SLOT);
+        flowMask_ = FLOW_TABLE_SIZE - 1;
+        numFlows_ = 0;
+
         hoManager_ = NULL;
 
+        hoHoldQueueSize_ = par("handoverHoldQueueSize");
+        hoBatchForwarding_ = par("batchHandoverForwarding");
+        hoForwardingInterval_ = par("handoverForwardingInterval");
+        hoForwardingTimer_ = new cMessage("hoForwardingTimer");
+
+        handoverInterruptionTime_ = registerSignal("handoverInterruptionTime");
+        handoverForwardedBytes_ = registerSignal("handoverForwardedBytes");
+
         binder_ = getBinder();
 
         if (nodeType_ == ENODEB)
@@ -86,6 +107,12 @@ void IP2lte::initialize(int stage)
 
 void IP2lte::handleMessage(cMessage *msg)
 {
+    if (msg == hoForwardingTimer_)
+    {
+        flushHandoverForwarding();
+        return;
+    }
+
     if( nodeType_ == ENODEB )
     {
         // message from IP Layer: send to stack
@@ -143,54 +170,7 @@ void IP2lte::fromIpUe(IPv4Datagram * datagram)
     // Remove control info from IP datagram
     delete(datagram->removeControlInfo());
 
-    // obtain the encapsulated transport packet
-    cPacket * transportPacket = datagram->getEncapsulatedPacket();
-
-    // 5-Tuple infos
-    unsigned short srcPort = 0;
-    unsigned short dstPort = 0;
-    int transportProtocol = datagram->getTransportProtocol();
-    // TODO Add support to IPv6
-    IPv4Address srcAddr  = datagram->getSrcAddress() ,
-                destAddr = datagram->getDestAddress();
-
-    // if needed, create a new structure for the flow
-    AddressPair pair(srcAddr, destAddr);
-    if (seqNums_.find(pair) == seqNums_.end())
-    {
-        std::pair<AddressPair, unsigned int> p(pair, 0);
-        seqNums_.insert(p);
-    }
-
-    int headerSize = datagram->getHeaderLength();
-
-    // inspect packet depending on the transport protocol type
-    switch (transportProtocol)
-    {
-        case IP_PROT_TCP:
-            inet::tcp::TCPSegment* tcpseg;
-            tcpseg = check_and_cast<inet::tcp::TCPSegment*>(transportPacket);
-            srcPort = tcpseg->getSrcPort();
-            dstPort = tcpseg->getDestPort();
-            headerSize += tcpseg->getHeaderLength();
-            break;
-        case IP_PROT_UDP:
-            UDPPacket* udppacket;
-            udppacket = check_and_cast<UDPPacket*>(transportPacket);
-            srcPort = udppacket->getSourcePort();
-            dstPort = udppacket->getDestinationPort();
-            headerSize += UDP_HEADER_BYTES;
-            break;
-    }
-
-    FlowControlInfo *controlInfo = new FlowControlInfo();
-    controlInfo->setSrcAddr(srcAddr.getInt());
-    controlInfo->setDstAddr(destAddr.getInt());
-    controlInfo->setSrcPort(srcPort);
-    controlInfo->setDstPort(dstPort);
-//    controlInfo->setSequenceNumber(seqNum_++);
-    controlInfo->setSequenceNumber(seqNums_[pair]++);
-    controlInfo->setHeaderSize(headerSize);
+    FlowControlInfo *controlInfo = createControlInfo(datagram, datagram->getHeaderLength());
     printControlInfo(controlInfo);
 
     datagram->setControlInfo(controlInfo);
@@ -220,7 +200,7 @@ void IP2lte::fromIpEnb(IPv4Datagram * datagram)
     {
         // data packet must be forwarded (via X2) to another eNB
         MacNodeId targetEnb = hoForwarding_.at(destId);
-        sendTunneledPacketOnHandover(datagram, targetEnb);
+        sendTunneledPacketOnHandover(datagram, destId, targetEnb);
         return;
     }
 
@@ -228,13 +208,7 @@ void IP2lte::fromIpEnb(IPv4Datagram * datagram)
     if (hoHolding_.find(destId) != hoHolding_.end())
     {
         // hold packets until handover is complete
-        if (hoFromIp_.find(destId) == hoFromIp_.end())
-        {
-            IpDatagramQueue queue;
-            hoFromIp_[destId] = queue;
-        }
-
-        hoFromIp_[destId].push_back(datagram);
+        holdDatagram(hoFromIp_, destId, datagram);
         return;
     }
 
@@ -248,6 +222,24 @@ void IP2lte::toIpEnb(cMessage * msg)
 }
 
 void IP2lte::toStackEnb(IPv4Datagram* datagram)
+{
+    // TODO Add support to IPv6
+    MacNodeId destId = binder_->getMacNodeId(datagram->getDestAddress());
+
+    FlowControlInfo *controlInfo = createControlInfo(datagram, 0);
+
+    // TODO Relay management should be placed here
+    MacNodeId master = binder_->getNextHop(destId);
+
+    controlInfo->setDestId(master);
+    printControlInfo(controlInfo);
+    datagram->setControlInfo(controlInfo);
+
+    send(datagram,stackGateOut_);
+}
+
+
+FlowControlInfo* IP2lte::createControlInfo(IPv4Datagram* datagram, int headerSize)
 {
     // obtain the encapsulated transport packet
     cPacket * transportPacket = datagram->getEncapsulatedPacket();
@@ -256,57 +248,138 @@ void IP2lte::toStackEnb(IPv4Datagram* datagram)
     unsigned short srcPort = 0;
     unsigned short dstPort = 0;
     int transportProtocol = datagram->getTransportProtocol();
+    // TODO Add support to IPv6
     IPv4Address srcAddr  = datagram->getSrcAddress() ,
                 destAddr = datagram->getDestAddress();
-    MacNodeId destId = binder_->getMacNodeId(destAddr);
 
-    // if needed, create a new structure for the flow
-    AddressPair pair(srcAddr, destAddr);
-    if (seqNums_.find(pair) == seqNums_.end())
+    // inspect packet depending on the transport protocol type
+    // (the TCP header size is read from each segment, since it depends on the options)
+    switch (transportProtocol)
     {
-        std::pair<AddressPair, unsigned int> p(pair, 0);
-        seqNums_.insert(p);
+        case IP_PROT_TCP:
+            inet::tcp::TCPSegment* tcpseg;
+            tcpseg = check_and_cast<inet::tcp::TCPSegment*>(transportPacket);
+            srcPort = tcpseg->getSrcPort();
+            dstPort = tcpseg->getDestPort();
+            headerSize += tcpseg->getHeaderLength();
+            break;
+        case IP_PROT_UDP:
+            inet::UDPPacket* udppacket;
+            udppacket = check_and_cast<inet::UDPPacket*>(transportPacket);
+            srcPort = udppacket->getSourcePort();
+            dstPort = udppacket->getDestinationPort();
+            headerSize += UDP_HEADER_BYTES;
+            break;
     }
 
-    int headerSize = 0;
+    // release the state of the flows that are no longer active
+    if (NOW - lastFlowPurge_ >= flowIdleTimeout_)
+        purgeIdleFlows();
 
-    switch(transportProtocol)
+    // if needed, create a new structure for the flow
+    FlowKey key;
+    key.srcAddr = srcAddr.getInt();
+    key.dstAddr = destAddr.getInt();
+    key.srcPort = srcPort;
+    key.dstPort = dstPort;
+    key.protocol = transportProtocol;
+    unsigned int slot = findFlowSlot(key);
+    if (flowSlots_[slot] == EMPTY_FLOW_SLOT)
     {
-        case IP_PROT_TCP:
-        inet::tcp::TCPSegment* tcpseg;
-        tcpseg = check_and_cast<inet::tcp::TCPSegment*>(transportPacket);
-        srcPort = tcpseg->getSrcPort();
-        dstPort = tcpseg->getDestPort();
-        headerSize += tcpseg->getHeaderLength();
-        break;
-        case IP_PROT_UDP:
-        inet::UDPPacket* udppacket;
-        udppacket = check_and_cast<inet::UDPPacket*>(transportPacket);
-        srcPort = udppacket->getSourcePort();
-        dstPort = udppacket->getDestinationPort();
-        headerSize += UDP_HEADER_BYTES;
-        break;
+        // keep the load factor below 1/2, so that probe sequences stay short
+        if (2 * (numFlows_ + 1) > flowMask_ + 1)
+        {
+            rehashFlows(2 * (flowMask_ + 1));
+            slot = findFlowSlot(key);
+        }
+
+        // reuse the entry of a removed flow, if any
+        unsigned int flowIndex;
+        if (!freeFlows_.empty())
+        {
+            flowIndex = freeFlows_.back();
+            freeFlows_.pop_back();
+        }
+        else
+        {
+            flowIndex = flows_.size();
+            flows_.push_back(FlowState());
+        }
+        flowSlots_[slot] = flowIndex;
+        numFlows_++;
+
+        FlowState& flow = flows_[flowIndex];
+        flow.key_ = key;
+        flow.template_ = new FlowControlInfo();
+        flow.template_->setSrcAddr(srcAddr.getInt());
+        flow.template_->setDstAddr(destAddr.getInt());
+        flow.template_->setSrcPort(srcPort);
+        flow.template_->setDstPort(dstPort);
+        // sequence numbers are shared by all the flows between the same pair of addresses
+        flow.seqNum_ = &seqNums_[AddressPair(srcAddr, destAddr)];
     }
 
-    FlowControlInfo *controlInfo = new FlowControlInfo();
-    controlInfo->setSrcAddr(srcAddr.getInt());
-    controlInfo->setDstAddr(destAddr.getInt());
-    controlInfo->setSrcPort(srcPort);
-    controlInfo->setDstPort(dstPort);
-//    controlInfo->setSequenceNumber(seqNum_++);
-    controlInfo->setSequenceNumber(seqNums_[pair]++);
+    FlowState& flow = flows_[flowSlots_[slot]];
+    flow.lastUse_ = NOW;
+    FlowControlInfo *controlInfo = flow.template_->dup();
+    controlInfo->setSequenceNumber((*flow.seqNum_)++);
     controlInfo->setHeaderSize(headerSize);
+    return controlInfo;
+}
 
-    // TODO Relay management should be placed here
-    MacNodeId master = binder_->getNextHop(destId);
+void IP2lte::purgeIdleFlows()
+{
+    unsigned int removed = 0;
+    for (unsigned int i = 0; i < flows_.size(); i++)
+    {
+        FlowState& flow = flows_[i];
+        if (flow.template_ == NULL || NOW - flow.lastUse_ < flowIdleTimeout_)
+            continue;
+
+        delete flow.template_;
+        flow.template_ = NULL;
+        freeFlows_.push_back(i);
+        removed++;
+    }
+    lastFlowPurge_ = NOW;
 
-    controlInfo->setDestId(master);
-    printControlInfo(controlInfo);
-    datagram->setControlInfo(controlInfo);
+    if (removed > 0)
+    {
+        // removing flows breaks the probe sequences of the remaining ones:
+        // reinsert them in a table of the same size
+        numFlows_ -= removed;
+        rehashFlows(flowMask_ + 1);
+    }
+}
 
-    send(datagram,stackGateOut_);
+unsigned int IP2lte::findFlowSlot(const FlowKey& key) const
+{
+    uint64_t h = ((uint64_t)key.srcAddr << 32) | key.dstAddr;
+    h ^= (((uint64_t)key.srcPort << 32) | ((uint64_t)key.dstPort << 16) | (key.protocol & 0xFFFF)) * 0x9E3779B97F4A7C15ULL;
+
+    // 64-bit finalizer (MurmurHash3)
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+
+    unsigned int slot = (unsigned int)h & flowMask_;
+    while (flowSlots_[slot] != EMPTY_FLOW_SLOT && !(flows_[flowSlots_[slot]].key_ == key))
+        slot = (slot + 1) & flowMask_;        // Linear scanning of the hash table
+    return slot;
 }
 
+void IP2lte::rehashFlows(unsigned int capacity)
+{
+    flowSlots_.assign(capacity, EMPTY_FLOW_SLOT);
+    flowMask_ = capacity - 1;
+    for (unsigned int i = 0; i < flows_.size(); i++)
+    {
+        if (flows_[i].template_ != NULL)
+            flowSlots_[findFlowSlot(flows_[i].key_)] = i;
+    }
+}
 
 void IP2lte::printControlInfo(FlowControlInfo* ci)
 {
@@ -377,35 +450,82 @@ void IP2lte::triggerHandoverTarget(MacNodeId ueId, MacNodeId sourceEnb)
 
     // reception of handover command from X2
     hoHolding_.insert(ueId);
+    hoHoldingStart_[ueId] = NOW;
 }
 
 
-void IP2lte::sendTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId targetEnb)
+void IP2lte::sendTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId ueId, MacNodeId targetEnb)
 {
     EV << "IP2lte::sendTunneledPacketOnHandover - destination is handing over to eNB " << targetEnb << ". Forward packet via X2." << endl;
+    hoForwardedBytes_[ueId] += datagram->getByteLength();
+
+    if (hoBatchForwarding_)
+    {
+        // the datagram will be sent along with the others queued for the same UE
+        hoToX2_[ueId].push_back(datagram);
+        if (!hoForwardingTimer_->isScheduled())
+            scheduleAt(NOW + hoForwardingInterval_, hoForwardingTimer_);
+        return;
+    }
+
     if (hoManager_ == NULL)
         hoManager_ = check_and_cast<LteHandoverManager*>(getParentModule()->getSubmodule("handoverManager"));
     hoManager_->forwardDataToTargetEnb(datagram, targetEnb);
 }
 
+void IP2lte::flushHandoverForwarding(MacNodeId ueId)
+{
+    if (hoManager_ == NULL)
+        hoManager_ = check_and_cast<LteHandoverManager*>(getParentModule()->getSubmodule("handoverManager"));
+
+    std::map<MacNodeId, IpDatagramQueue>::iterator it = (ueId == 0) ? hoToX2_.begin() : hoToX2_.find(ueId);
+    while (it != hoToX2_.end() && (ueId == 0 || it->first == ueId))
+    {
+        if (!it->second.empty())
+        {
+            EV << "IP2lte::flushHandoverForwarding - forwarding " << it->second.size() << " packets of UE " << it->first << " via X2." << endl;
+            hoManager_->forwardDataToTargetEnb(it->second, hoForwarding_.at(it->first));
+        }
+        hoToX2_.erase(it++);
+    }
+}
+
+void IP2lte::holdDatagram(std::map<MacNodeId, IpDatagramQueue>& queues, MacNodeId ueId, IPv4Datagram* datagram)
+{
+    IpDatagramQueue& queue = queues[ueId];
+    if (hoHoldQueueSize_ > 0 && queue.size() >= (unsigned int) hoHoldQueueSize_)
+    {
+        EV << "IP2lte::holdDatagram - handover queue of UE " << ueId << " is full. Packet dropped" << endl;
+        delete datagram;
+        return;
+    }
+    queue.push_back(datagram);
+}
+
 void IP2lte::receiveTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId sourceEnb)
 {
     EV << "IP2lte::receiveTunneledPacketOnHandover - received packet via X2 from " << sourceEnb << endl;
     IPv4Address destAddr = datagram->getDestAddress();
     MacNodeId destId = binder_->getMacNodeId(destAddr);
-    if (hoFromX2_.find(destId) == hoFromX2_.end())
-    {
-        IpDatagramQueue queue;
-        hoFromX2_[destId] = queue;
-    }
-
-    hoFromX2_[destId].push_back(datagram);
+    holdDatagram(hoFromX2_, destId, datagram);
 }
 
 void IP2lte::signalHandoverCompleteSource(MacNodeId ueId, MacNodeId targetEnb)
 {
+    Enter_Method("signalHandoverCompleteSource");
+
     EV << NOW << " IP2lte::signalHandoverCompleteSource - handover of UE " << ueId << " to eNB " << targetEnb << " completed!" << endl;
+
+    // send the datagrams still waiting to be forwarded
+    flushHandoverForwarding(ueId);
     hoForwarding_.erase(ueId);
+
+    std::map<MacNodeId, int64_t>::iterator bit = hoForwardedBytes_.find(ueId);
+    if (bit != hoForwardedBytes_.end())
+    {
+        emit(handoverForwardedBytes_, (long) bit->second);
+        hoForwardedBytes_.erase(bit);
+    }
 }
 
 void IP2lte::signalHandoverCompleteTarget(MacNodeId ueId, MacNodeId sourceEnb)
@@ -453,10 +573,31 @@ void IP2lte::signalHandoverCompleteTarget(MacNodeId ueId, MacNodeId sourceEnb)
 
     hoHolding_.erase(ueId);
 
+    std::map<MacNodeId, simtime_t>::iterator sit = hoHoldingStart_.find(ueId);
+    if (sit != hoHoldingStart_.end())
+    {
+        emit(handoverInterruptionTime_, NOW - sit->second);
+        hoHoldingStart_.erase(sit);
+    }
 }
 
 IP2lte::~IP2lte()
 {
+    cancelAndDelete(hoForwardingTimer_);
+
+    std::map<MacNodeId, IpDatagramQueue>::iterator qit;
+    for (qit = hoToX2_.begin(); qit != hoToX2_.end(); ++qit)
+    {
+        while (!qit->second.empty())
+        {
+            delete qit->second.front();
+            qit->second.pop_front();
+        }
+    }
+
+    for (unsigned int i = 0; i < flows_.size(); i++)
+        delete flows_[i].template_;
+
     std::map<MacNodeId, IpDatagramQueue>::iterator it;
     for (it = hoFromX2_.begin(); it != hoFromX2_.end(); ++it)
     {
@@ -19,6 +19,12 @@
 
 class LteHandoverManager;
 
+/// Initial number of slots of the flow table (must be a power of two)
+#define FLOW_TABLE_SIZE 64
+
+/// Flow table slot not associated to any flow
+#define EMPTY_FLOW_SLOT 0xFFFFFFFF
+
 // a sort of five-tuple with only two elements (a two-tuple...), src and dst addresses
 typedef std::pair<IPv4Address, IPv4Address> AddressPair;
 
@@ -35,6 +41,52 @@ class IP2lte : public cSimpleModule
     // TODO move numbering to PDCP
     std::map<AddressPair, unsigned int> seqNums_;
 
+    // five-tuple identifying a flow
+    struct FlowKey
+    {
+        uint32 srcAddr;
+        uint32 dstAddr;
+        unsigned short srcPort;
+        unsigned short dstPort;
+        int protocol;
+
+        bool operator==(const FlowKey& other) const
+        {
+            return srcAddr == other.srcAddr && dstAddr == other.dstAddr &&
+                srcPort == other.srcPort && dstPort == other.dstPort && protocol == other.protocol;
+        }
+    };
+
+    /*
+     * Per-flow state. The first datagram of a flow (addresses, ports and transport protocol)
+     * creates an entry holding the control info template and a pointer to the sequence
+     * counter of its address pair, so that the following datagrams are classified
+     * with a single probe of the flow table. Flows idle for longer than flowIdleTimeout_
+     * are removed and their entries are reused by new flows
+     */
+    struct FlowState
+    {
+        FlowKey key_;                   // five-tuple of the flow
+        FlowControlInfo* template_;     // four-tuple already set, NULL if the entry is free
+        unsigned int* seqNum_;          // counter of the flow in seqNums_
+        simtime_t lastUse_;             // arrival time of the last datagram of the flow
+    };
+    std::vector<FlowState> flows_;
+    // indexes of the free entries in flows_
+    std::vector<unsigned int> freeFlows_;
+
+    // flow table: open addressing with linear probing over a power-of-two number of slots,
+    // each slot holds the index in flows_ of a flow or EMPTY_FLOW_SLOT
+    std::vector<unsigned int> flowSlots_;
+    // number of slots minus one
+    unsigned int flowMask_;
+    // number of flows in the table
+    unsigned int numFlows_;
+
+    simtime_t flowIdleTimeout_;
+    // last time idle flows were removed
+    simtime_t lastFlowPurge_;
+
     // obsolete with the above map
     unsigned int seqNum_;       // datagram sequence number (RLC fragmentation needs it)
 
@@ -59,6 +111,22 @@ class IP2lte : public cSimpleModule
     std::map<MacNodeId, IpDatagramQueue> hoFromX2_;
     std::map<MacNodeId, IpDatagramQueue> hoFromIp_;
 
+    // max number of datagrams held for each UE completing handover (0 means infinite)
+    int hoHoldQueueSize_;
+
+    // batched forwarding: datagrams to be tunneled are queued per UE and sent
+    // within a single X2 message when hoForwardingTimer_ expires
+    bool hoBatchForwarding_;
+    simtime_t hoForwardingInterval_;
+    cMessage* hoForwardingTimer_;
+    std::map<MacNodeId, IpDatagramQueue> hoToX2_;
+
+    // statistics
+    std::map<MacNodeId, simtime_t> hoHoldingStart_;         // target eNB: start of the holding period of each UE
+    std::map<MacNodeId, int64_t> hoForwardedBytes_;         // source eNB: bytes forwarded for each UE
+    simsignal_t handoverInterruptionTime_;
+    simsignal_t handoverForwardedBytes_;
+
     /**
      * Handle packets from transport layer and forward them to the stack
      */
@@ -70,7 +138,40 @@ class IP2lte : public cSimpleModule
      */
     void toIpUe(IPv4Datagram *datagram);
 
+    /**
+     * Builds the control info for the given datagram, creating the state of its flow if needed
+     *
+     * @param headerSize size of the headers preceding the transport one (added to the transport header size)
+     */
+    FlowControlInfo* createControlInfo(IPv4Datagram* datagram, int headerSize);
+
+    /**
+     * Removes the flows idle for longer than flowIdleTimeout_
+     */
+    void purgeIdleFlows();
+
+    /**
+     * Returns the slot of the flow table holding the given flow, or the empty slot
+     * ending its probe sequence if the flow is not in the table
+     */
+    unsigned int findFlowSlot(const FlowKey& key) const;
+
+    /**
+     * Moves all the flows to a new flow table of the given size (power of two)
+     */
+    void rehashFlows(unsigned int capacity);
+
     void fromIpEnb(IPv4Datagram * datagram);
+
+    /**
+     * Holds a datagram destined to a UE completing handover, unless its queue is full
+     */
+    void holdDatagram(std::map<MacNodeId, IpDatagramQueue>& queues, MacNodeId ueId, IPv4Datagram* datagram);
+
+    /**
+     * Sends the datagrams queued for the given UE (or for all UEs, if ueId is 0) over X2
+     */
+    void flushHandoverForwarding(MacNodeId ueId = 0);
     void toIpEnb(cMessage * msg);
     void toStackEnb(IPv4Datagram* datagram);
 
@@ -97,10 +198,11 @@ class IP2lte : public cSimpleModule
   public:
     void triggerHandoverSource(MacNodeId ueId, MacNodeId targetEnb);
     void triggerHandoverTarget(MacNodeId ueId, MacNodeId sourceEnb);
-    void sendTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId targetEnb);
+    void sendTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId ueId, MacNodeId targetEnb);
     void receiveTunneledPacketOnHandover(IPv4Datagram* datagram, MacNodeId sourceEnb);
     void signalHandoverCompleteSource(MacNodeId ueId, MacNodeId targetEnb);
     void signalHandoverCompleteTarget(MacNodeId ueId, MacNodeId sourceEnb);
+    IP2lte();
     virtual ~IP2lte();
 
 };
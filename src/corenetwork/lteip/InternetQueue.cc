@@ -8,6 +8,7 @@
 //
 
 #include "corenetwork/lteip/InternetQueue.h"
+#include <math.h>
 
 Define_Module(InternetQueue);
 
@@ -32,6 +33,38 @@ void InternetQueue::initialize()
     queueSize_ = par("queueSize");
     queueSize_ = (queueSize_ > 0) ? queueSize_ : 0; // 0 means infinite
 
+    batchSize_ = par("batchSize");
+    if (batchSize_ < 1)
+        error("InternetQueue::initialize - batchSize must be at least 1");
+    burstLength_ = 0;
+
+    // read active queue management parameters
+    std::string aqm = par("aqm").stdstringValue();
+    if (aqm == "taildrop")
+        aqm_ = TAIL_DROP;
+    else if (aqm == "red")
+        aqm_ = RED;
+    else if (aqm == "codel")
+        aqm_ = CODEL;
+    else
+        error("InternetQueue::initialize - unknown aqm %s", aqm.c_str());
+
+    redWq_ = par("redWq");
+    redMinTh_ = par("redMinTh");
+    redMaxTh_ = par("redMaxTh");
+    redMaxP_ = par("redMaxP");
+    if (aqm_ == RED && redMaxTh_ <= redMinTh_)
+        error("InternetQueue::initialize - redMaxTh must be greater than redMinTh");
+    redAvg_ = 0;
+    idleSince_ = 0;
+
+    codelTarget_ = par("codelTarget");
+    codelInterval_ = par("codelInterval");
+    codelFirstAboveTime_ = 0;
+    codelDropNext_ = 0;
+    codelCount_ = 0;
+    codelDropping_ = false;
+
     // initialize statistics
     numSent_ = numDropped_ = 0;
 
@@ -73,13 +106,14 @@ void InternetQueue::handleMessage(cMessage *msg)
     if (msg == endTransmissionEvent_)
     {
         // Transmission finished, we can start next one.
-        numSent_++;
+        numSent_ += burstLength_;
+        burstLength_ = 0;
         EV << "Transmission finished" << endl;
-        if (!txQueue_.isEmpty())
-        {
-            cPacket *pk = (cPacket *) txQueue_.pop();
+        cPacket *pk = dequeue();
+        if (pk != NULL)
             startTransmitting(pk);
-        }
+        else
+            idleSince_ = NOW;
     }
 
     // packet from LteIp module arrived on gate "lteIPIn"
@@ -90,22 +124,16 @@ void InternetQueue::handleMessage(cMessage *msg)
             // We are currently busy, so just queue up the packet
             EV << "Received " << msg
                << " for transmission but transmitter busy, queuing." << endl;
-
-            // if the queue has a finite length and it is full, drop the packet
-            if (queueSize_ && txQueue_.getLength() >= queueSize_)
-            {
-                EV << "The transmission queue is full. Packet dropped" << endl;
-                numDropped_++;
-                delete msg;
-            }
-            else
-                txQueue_.insert(msg);
+            enqueue(check_and_cast<cPacket *>(msg));
         }
         else
         {
             // We are idle, so we can start transmitting right away.
             EV << "Received " << msg << " for transmission\n";
-            startTransmitting(check_and_cast<cPacket *>(msg));
+            cPacket *pkt = check_and_cast<cPacket *>(msg);
+            if (aqm_ == RED)
+                redIdleDecay(pkt);
+            startTransmitting(pkt);
         }
     }
 
@@ -118,6 +146,19 @@ void InternetQueue::startTransmitting(cPacket *pkt)
     // Send
     EV << "Starting transmission of " << pkt << endl;
     send(pkt, queueOutGate_);
+    burstLength_ = 1;
+
+    // batched mode: hand the following packets to the channel now, each one
+    // starting when the previous one will be over
+    while (burstLength_ < batchSize_)
+    {
+        cPacket *next = dequeue();
+        if (next == NULL)
+            break;
+        EV << "Starting transmission of " << next << " at " << datarateChannel_->getTransmissionFinishTime() << endl;
+        sendDelayed(next, datarateChannel_->getTransmissionFinishTime() - NOW, queueOutGate_);
+        burstLength_++;
+    }
 
     // Schedule an event for the time when last bit will leave the gate.
     simtime_t endTransmissionTime =
@@ -126,6 +167,117 @@ void InternetQueue::startTransmitting(cPacket *pkt)
     EV << "The transmission will finish at simtime: " << endTransmissionTime << endl;
 }
 
+void InternetQueue::enqueue(cPacket *pkt)
+{
+    // if the queue has a finite length and it is full, drop the packet
+    if (queueSize_ && txQueue_.getLength() >= queueSize_)
+    {
+        EV << "The transmission queue is full. Packet dropped" << endl;
+        numDropped_++;
+        delete pkt;
+        return;
+    }
+
+    if (aqm_ == RED)
+    {
+        // update the average queue length and drop with a probability growing
+        // linearly between the two thresholds
+        redAvg_ = (1 - redWq_) * redAvg_ + redWq_ * txQueue_.getLength();
+        bool drop = false;
+        if (redAvg_ >= redMaxTh_)
+            drop = true;
+        else if (redAvg_ >= redMinTh_)
+            drop = uniform(0, 1) < redMaxP_ * (redAvg_ - redMinTh_) / (redMaxTh_ - redMinTh_);
+
+        if (drop)
+        {
+            EV << "RED: average queue length " << redAvg_ << ". Packet dropped" << endl;
+            numDropped_++;
+            delete pkt;
+            return;
+        }
+    }
+
+    txQueue_.insert(pkt);
+    enqueueTimes_.push_back(NOW);
+}
+
+cPacket* InternetQueue::dequeue()
+{
+    while (!txQueue_.isEmpty())
+    {
+        cPacket *pkt = (cPacket *) txQueue_.pop();
+        simtime_t sojourn = NOW - enqueueTimes_.front();
+        enqueueTimes_.pop_front();
+
+        if (aqm_ != CODEL)
+            return pkt;
+
+        bool okToDrop = codelOkToDrop(sojourn);
+        bool drop = false;
+        bool entering = false;
+        if (codelDropping_)
+        {
+            if (!okToDrop)
+                codelDropping_ = false;     // sojourn time below target: leave dropping state
+            else if (NOW >= codelDropNext_)
+            {
+                drop = true;
+                codelCount_++;
+            }
+        }
+        else if (okToDrop)
+        {
+            // enter dropping state, resuming the previous drop rate if it was left recently
+            drop = true;
+            entering = true;
+            codelDropping_ = true;
+            codelCount_ = (NOW - codelDropNext_ < codelInterval_ && codelCount_ > 2) ? codelCount_ - 2 : 1;
+        }
+
+        if (!drop)
+            return pkt;
+
+        // control law: the interval between drops shrinks with the square root of the drop count.
+        // In dropping state the next drop is scheduled from the previous one, so that the
+        // drop rate keeps increasing while the sojourn time stays above target
+        if (entering)
+            codelDropNext_ = NOW + codelInterval_ / sqrt((double) codelCount_);
+        else
+            codelDropNext_ += codelInterval_ / sqrt((double) codelCount_);
+        EV << "CoDel: sojourn time " << sojourn << ". Packet dropped" << endl;
+        numDropped_++;
+        delete pkt;
+    }
+    return NULL;
+}
+
+bool InternetQueue::codelOkToDrop(simtime_t sojourn)
+{
+    // do not drop the last packet of the queue
+    if (sojourn < codelTarget_ || txQueue_.isEmpty())
+    {
+        codelFirstAboveTime_ = 0;
+        return false;
+    }
+    if (codelFirstAboveTime_ == 0)
+    {
+        codelFirstAboveTime_ = NOW + codelInterval_;
+        return false;
+    }
+    return NOW >= codelFirstAboveTime_;
+}
+
+void InternetQueue::redIdleDecay(cPacket *pkt)
+{
+    // number of packets that could have been transmitted while the queue was idle
+    double datarate = (datarateChannel_ != NULL) ? datarateChannel_->getNominalDatarate() : 0;
+    if (datarate <= 0 || pkt->getBitLength() <= 0)
+        return;
+    double m = (NOW - idleSince_).dbl() * datarate / pkt->getBitLength();
+    redAvg_ *= pow(1 - redWq_, m);
+}
+
 void InternetQueue::updateDisplayString()
 {
     char buf[80] = "";
@@ -11,6 +11,7 @@
 #define _LTE_INTERNETQUEUE_H_
 
 #include <omnetpp.h>
+#include <deque>
 
 using namespace omnetpp;
 
@@ -27,9 +28,22 @@ using namespace omnetpp;
  * If the channel is busy, the packet is stored in a queue.
  * The size of the queue is configurable ( 0 = infinite ).
  *
+ * In batched mode (batchSize > 1) a burst of queued packets is passed
+ * to the channel with a single end-of-transmission event.
+ * Packets can be dropped before the queue is full by RED (on enqueue)
+ * or CoDel (on dequeue).
+ *
  */
 class InternetQueue : public cSimpleModule
 {
+  public:
+
+    /// Active queue management
+    enum AqmType
+    {
+        TAIL_DROP, RED, CODEL
+    };
+
   protected:
 
     cQueue txQueue_;                     /// Transmission queue
@@ -37,6 +51,27 @@ class InternetQueue : public cSimpleModule
     cMessage *endTransmissionEvent_;     /// Self message that notifies the end of a transmission
     cGate *queueOutGate_;                /// Output gate towards the datarate channel
     cChannel *datarateChannel_;          /// Datarate Channel
+    std::deque<simtime_t> enqueueTimes_; /// Insertion time of the packets in txQueue_
+
+    int batchSize_;                      /// Max number of packets per end-of-transmission event
+    int burstLength_;                    /// Number of packets of the ongoing transmission
+    AqmType aqm_;                        /// Active queue management
+
+    // RED
+    double redWq_;
+    double redMinTh_;
+    double redMaxTh_;
+    double redMaxP_;
+    double redAvg_;                      /// Average queue length
+    simtime_t idleSince_;                /// Time when the transmitter became idle with an empty queue
+
+    // CoDel
+    simtime_t codelTarget_;
+    simtime_t codelInterval_;
+    simtime_t codelFirstAboveTime_;      /// Time when the sojourn time will have been above target for an interval
+    simtime_t codelDropNext_;            /// Time of the next drop in dropping state
+    unsigned int codelCount_;            /// Number of drops in the current dropping state
+    bool codelDropping_;
 
     // statistics
     int numSent_;       /// number of packets sent
@@ -81,11 +116,41 @@ class InternetQueue : public cSimpleModule
      * The function sends the packet over the channel, then schedules
      * an endOfTransmissionEvent, to know when the channel
      * is idle again.
+     * In batched mode, up to batchSize - 1 queued packets are sent
+     * after it and the event is scheduled at the end of the last one.
      *
      * @param msg packet received for transmission
      */
     virtual void startTransmitting(cPacket *pkt);
 
+    /**
+     * Inserts a packet in the transmission queue, unless the queue
+     * is full or RED decides to drop it.
+     *
+     * @param pkt packet to be queued
+     */
+    virtual void enqueue(cPacket *pkt);
+
+    /**
+     * Extracts the next packet from the transmission queue,
+     * dropping the packets selected by CoDel.
+     *
+     * @return the packet, NULL if the queue is empty
+     */
+    virtual cPacket* dequeue();
+
+    /**
+     * CoDel: checks whether the sojourn time has been above target for at least an interval
+     */
+    bool codelOkToDrop(simtime_t sojourn);
+
+    /**
+     * RED: decays the average queue length for the time the queue has been idle,
+     * as if a packet of the size of pkt had been transmitted from an empty queue
+     * during that time
+     */
+    void redIdleDecay(cPacket *pkt);
+
   private:
 
     /**
@@ -0,0 +1,143 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "epc/TrafficFlowClassifier.h"
+
+TrafficFlowClassifier::TrafficFlowClassifier(unsigned int capacity)
+{
+    unsigned int slots = 1;
+    while (slots < capacity)
+        slots <<= 1;
+
+    Entry empty;
+    empty.tftId_ = UNSPECIFIED_TFT;
+    ht_.assign(slots, empty);
+    mask_ = slots - 1;
+    size_ = 0;
+
+    CacheEntry invalid;
+    invalid.valid_ = false;
+    cache_.assign(TFT_CACHE_SIZE, invalid);
+    cacheHits_ = 0;
+    cacheMisses_ = 0;
+}
+
+unsigned int TrafficFlowClassifier::hash_func(uint32_t primary, uint32_t addr,
+    unsigned int srcPort, unsigned int destPort) const
+{
+    // ports may be UNSPECIFIED_PORT (65536), so they are given 32 bits each
+    uint64_t h = ((uint64_t)primary << 32) | addr;
+    h ^= (((uint64_t)srcPort << 32) | destPort) * 0x9E3779B97F4A7C15ULL;
+
+    // 64-bit finalizer (MurmurHash3)
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return (unsigned int)h;
+}
+
+TrafficFlowTemplateId TrafficFlowClassifier::find(uint32_t primary, uint32_t addr,
+    unsigned int srcPort, unsigned int destPort) const
+{
+    unsigned int hashIndex = hash_func(primary, addr, srcPort, destPort) & mask_;
+    while (ht_[hashIndex].tftId_ != UNSPECIFIED_TFT)     // an empty slot ends the probe sequence
+    {
+        const Entry& e = ht_[hashIndex];
+        if (e.primary_ == primary && e.addr_ == addr && e.srcPort_ == srcPort && e.destPort_ == destPort)
+            return e.tftId_;
+        hashIndex = (hashIndex + 1) & mask_;        // Linear scanning of the hash table
+    }
+    return UNSPECIFIED_TFT;
+}
+
+bool TrafficFlowClassifier::insert(uint32_t primary, uint32_t addr, unsigned int srcPort,
+    unsigned int destPort, TrafficFlowTemplateId tftId)
+{
+    // first match wins: later templates with the same key are never reachable
+    if (find(primary, addr, srcPort, destPort) != UNSPECIFIED_TFT)
+        return false;
+
+    // keep the load factor below 1/2, so that probe sequences stay short
+    if (2 * (size_ + 1) > mask_ + 1)
+        rehash(2 * (mask_ + 1));
+
+    unsigned int hashIndex = hash_func(primary, addr, srcPort, destPort) & mask_;
+    while (ht_[hashIndex].tftId_ != UNSPECIFIED_TFT)
+        hashIndex = (hashIndex + 1) & mask_;
+    ht_[hashIndex].primary_ = primary;
+    ht_[hashIndex].addr_ = addr;
+    ht_[hashIndex].srcPort_ = srcPort;
+    ht_[hashIndex].destPort_ = destPort;
+    ht_[hashIndex].tftId_ = tftId;
+    size_++;
+
+    // cached decisions (including misses) may be stale now
+    flushCache();
+    return true;
+}
+
+TrafficFlowTemplateId TrafficFlowClassifier::classify(uint32_t primary, uint32_t addr,
+    unsigned int srcPort, unsigned int destPort)
+{
+    CacheEntry& c = cache_[hash_func(primary, addr, srcPort, destPort) & (TFT_CACHE_SIZE - 1)];
+    if (c.valid_ && c.primary_ == primary && c.addr_ == addr && c.srcPort_ == srcPort && c.destPort_ == destPort)
+    {
+        cacheHits_++;
+        return c.tftId_;
+    }
+    cacheMisses_++;
+
+    // full 4-tuple
+    TrafficFlowTemplateId tftId = find(primary, addr, srcPort, destPort);
+
+    // src and dest addresses only (skipped if the ports were already unspecified)
+    if (tftId == UNSPECIFIED_TFT && (srcPort != UNSPECIFIED_PORT || destPort != UNSPECIFIED_PORT))
+        tftId = find(primary, addr, UNSPECIFIED_PORT, UNSPECIFIED_PORT);
+
+    // first key only
+    if (tftId == UNSPECIFIED_TFT && addr != 0)
+        tftId = find(primary, 0, UNSPECIFIED_PORT, UNSPECIFIED_PORT);
+
+    c.valid_ = true;
+    c.primary_ = primary;
+    c.addr_ = addr;
+    c.srcPort_ = srcPort;
+    c.destPort_ = destPort;
+    c.tftId_ = tftId;
+    return tftId;
+}
+
+void TrafficFlowClassifier::rehash(unsigned int capacity)
+{
+    std::vector<Entry> old;
+    old.swap(ht_);
+
+    Entry empty;
+    empty.tftId_ = UNSPECIFIED_TFT;
+    ht_.assign(capacity, empty);
+    mask_ = capacity - 1;
+
+    for (unsigned int i = 0; i < old.size(); i++)
+    {
+        if (old[i].tftId_ == UNSPECIFIED_TFT)
+            continue;
+        unsigned int hashIndex = hash_func(old[i].primary_, old[i].addr_, old[i].srcPort_, old[i].destPort_) & mask_;
+        while (ht_[hashIndex].tftId_ != UNSPECIFIED_TFT)
+            hashIndex = (hashIndex + 1) & mask_;
+        ht_[hashIndex] = old[i];
+    }
+}
+
+void TrafficFlowClassifier::flushCache()
+{
+    for (unsigned int i = 0; i < cache_.size(); i++)
+        cache_[i].valid_ = false;
+}
@@ -0,0 +1,126 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_TRAFFICFLOWCLASSIFIER_H_
+#define _LTE_TRAFFICFLOWCLASSIFIER_H_
+
+#include <vector>
+#include <stdint.h>
+#include "epc/gtp_common.h"
+
+/// Initial number of slots of the template table (must be a power of two)
+#define TFT_TABLE_SIZE 64
+
+/// Number of slots of the decision cache (must be a power of two)
+#define TFT_CACHE_SIZE 256
+
+/**
+ * @class TrafficFlowClassifier
+ * @brief Compiled form of a traffic filter table
+ *
+ * Every traffic flow template is stored in an open addressing hash table
+ * (linear probing over a power-of-two number of slots) keyed by the whole
+ * filter: primary address, secondary address, src and dest port.
+ * Wildcard fields are stored with their "unspecified" value, so that each
+ * of the three matching stages of the traffic flow filter
+ *  - full 4-tuple
+ *  - addresses only (ports unspecified)
+ *  - primary address only (secondary address 0.0.0.0, ports unspecified)
+ * costs a single probe sequence instead of a scan of the template list.
+ * Only the first template inserted for a given key is kept, which preserves
+ * the first-match semantics of the list based table.
+ *
+ * The result of the last classified flows is kept in a small direct-mapped
+ * cache, which is flushed whenever a template is added.
+ */
+class TrafficFlowClassifier
+{
+  public:
+    /**
+     * @param capacity initial number of slots (rounded up to a power of two)
+     */
+    TrafficFlowClassifier(unsigned int capacity = TFT_TABLE_SIZE);
+
+    /**
+     * Adds a template to the table
+     *
+     * @return false if a template with the very same key was already present
+     * (in this case the table is not modified)
+     */
+    bool insert(uint32_t primary, uint32_t addr, unsigned int srcPort, unsigned int destPort,
+        TrafficFlowTemplateId tftId);
+
+    /**
+     * Exact lookup of a template
+     *
+     * @return the tftId of the template, UNSPECIFIED_TFT if not found
+     */
+    TrafficFlowTemplateId find(uint32_t primary, uint32_t addr, unsigned int srcPort,
+        unsigned int destPort) const;
+
+    /**
+     * Runs the three matching stages (full 4-tuple, addresses only, primary address only)
+     * and returns the tftId of the first one that succeeds, UNSPECIFIED_TFT otherwise.
+     * The result is stored in the decision cache
+     */
+    TrafficFlowTemplateId classify(uint32_t primary, uint32_t addr, unsigned int srcPort,
+        unsigned int destPort);
+
+    /// Number of templates currently stored
+    unsigned int size() const { return size_; }
+
+    /// Number of classify() calls answered by the decision cache
+    unsigned long getCacheHits() const { return cacheHits_; }
+
+    /// Number of classify() calls that ran the matching stages
+    unsigned long getCacheMisses() const { return cacheMisses_; }
+
+  private:
+    unsigned int hash_func(uint32_t primary, uint32_t addr, unsigned int srcPort,
+        unsigned int destPort) const;
+
+    /// moves all the templates to a new table of the given size (power of two)
+    void rehash(unsigned int capacity);
+
+    /// empties the decision cache
+    void flushCache();
+
+    struct Entry
+    {
+        uint32_t primary_;
+        uint32_t addr_;
+        unsigned int srcPort_;
+        unsigned int destPort_;
+        TrafficFlowTemplateId tftId_;     // UNSPECIFIED_TFT marks an empty slot
+    };
+
+    struct CacheEntry
+    {
+        bool valid_;
+        uint32_t primary_;
+        uint32_t addr_;
+        unsigned int srcPort_;
+        unsigned int destPort_;
+        TrafficFlowTemplateId tftId_;
+    };
+
+    /// Hash table slots
+    std::vector<Entry> ht_;
+    /// Number of slots minus one
+    unsigned int mask_;
+    /// Number of used slots
+    unsigned int size_;
+
+    /// Decision cache, indexed by the hash of the classified flow
+    std::vector<CacheEntry> cache_;
+    unsigned long cacheHits_;
+    unsigned long cacheMisses_;
+};
+
+#endif
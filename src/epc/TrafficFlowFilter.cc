@@ -94,55 +94,25 @@ void TrafficFlowFilter::handleMessage(cMessage *msg)
     send(datagram,"gtpUserGateOut");
 }
 
-TrafficFlowTemplateId TrafficFlowFilter::findTrafficFlow(L3Address firstKey, TrafficFlowTemplate secondKey)
+void TrafficFlowFilter::finish()
 {
-    TrafficFilterTemplateTable::iterator tftIt;
-    tftIt = filterTable_.find(firstKey);
-
-    // if no entry found
-    if (tftIt == filterTable_.end())
-    {
-        EV << "TrafficFlowFilter::findTrafficFlow - Cannot find tft list for destAddress " << firstKey << "." << endl;
-        return UNSPECIFIED_TFT;
-    }
-
-        // obtain the filter list associated to the given address
-    TrafficFilterTemplateList & filterList = tftIt->second;
-
-    // search for the second key within the list
-    TrafficFilterTemplateList::iterator templIt = filterList.begin(),
-        templFirst = filterList.begin(),
-        templEt = filterList.end();
-
-    // try searching for the full entry (src-dest addresses and ports)
-    for (templIt = templFirst; templIt != templEt; templIt++)
-    {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
-    }
-    EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for the 4-tuple. Now trying with src and dest addresses" << endl;
+    // decision cache statistics
+    recordScalar("tftCacheHits", classifier_.getCacheHits());
+    recordScalar("tftCacheMisses", classifier_.getCacheMisses());
+}
 
-    // if no result is found, try leaving port fields unspecified
-    secondKey.srcPort = secondKey.destPort = UNSPECIFIED_PORT;
-    for (templIt = templFirst; templIt != templEt; templIt++)
-    {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
-    }
-    EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for src and dest addresses. Now trying with first key only" << endl;
+TrafficFlowTemplateId TrafficFlowFilter::findTrafficFlow(L3Address firstKey, TrafficFlowTemplate secondKey)
+{
+    // the classifier tries the full 4-tuple, then the src and dest addresses, then the first key only
+    TrafficFlowTemplateId tftId = classifier_.classify(firstKey.toIPv4().getInt(), secondKey.addr.toIPv4().getInt(),
+        secondKey.srcPort, secondKey.destPort);
 
-    // if no result is found again, search only for the first key
-    secondKey.addr.set(IPv4Address("0.0.0.0"));
-    for (templIt = templFirst; templIt != templEt; templIt++)
+    if (tftId == UNSPECIFIED_TFT)
     {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
+        EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for destAddress " << firstKey << " and values: ["
+           << secondKey.addr << "," << secondKey.destPort << "," << secondKey.srcPort << "]" << endl;
     }
-
-    EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for destAddress " << firstKey << " and values: ["
-       << secondKey.addr << "," << secondKey.destPort << "," << secondKey.srcPort << "]" << endl;
-
-    return UNSPECIFIED_TFT;
+    return tftId;
 }
 
 bool TrafficFlowFilter::addTrafficFlow(L3Address firstKey, TrafficFlowTemplate tft)
@@ -159,7 +129,13 @@ bool TrafficFlowFilter::addTrafficFlow(L3Address firstKey, TrafficFlowTemplate t
         return false;
     }
 
-    filterTable_[firstKey].push_back(tft);
+    if (!classifier_.insert(firstKey.toIPv4().getInt(), tft.addr.toIPv4().getInt(), tft.srcPort, tft.destPort, tft.tftId))
+    {
+        // a template with the same key shadows this one
+        EV << "TrafficFlowFilter::addTrafficFlow - entry with destAddress " << firstKey << " and values: ["
+           << tft.addr << "," << tft.destPort << "," << tft.srcPort << "] is unreachable" << endl;
+        return false;
+    }
 
     EV << "TrafficFlowFilter::addTrafficFlow - inserted entry: destAddr[" << firstKey << "] - TFT[" << tft.tftId << "]" << endl;
     return true;
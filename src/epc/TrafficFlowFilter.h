@@ -14,6 +14,7 @@
 //#include "trafficFlowTemplateMsg_m.h"
 #include "epc/gtp/TftControlInfo.h"
 #include "epc/gtp_common.h"
+#include "epc/TrafficFlowClassifier.h"
 
 using namespace inet;
 
@@ -31,6 +32,9 @@ using namespace inet;
  * be left unspecified and a new search will be performed. In case of another failure a last search with only the first key will be performed.
  * If no result is found even in this case, an error will be thrown.
  *
+ * The table is compiled into a TrafficFlowClassifier, where each of the above searches is a single hash lookup
+ * and the outcome for recently seen flows is cached.
+ *
  * This table is specified via (part of) a XML configuration file. Note that the fields of the TrafficFlowTemplates (except for the tftId) may
  * be left unspecified
  *
@@ -68,7 +72,8 @@ class TrafficFlowFilter : public cSimpleModule
     // gate for connecting with the GTP-U module
     cGate * gtpUserGate_;
 
-    TrafficFilterTemplateTable filterTable_;
+    // compiled traffic filter table
+    TrafficFlowClassifier classifier_;
 
     void loadFilterTable(const char * filterTableFile);
 
@@ -80,6 +85,9 @@ class TrafficFlowFilter : public cSimpleModule
     // TrafficFlowFilter module may receive messages only from the input interface of its compound module
     virtual void handleMessage(cMessage *msg);
 
+    // records the decision cache statistics of the classifier
+    virtual void finish();
+
     // functions for managing filter tables
     TrafficFlowTemplateId findTrafficFlow(L3Address firstKey, TrafficFlowTemplate secondKey);
     bool addTrafficFlow(L3Address firstKey, TrafficFlowTemplate tft);
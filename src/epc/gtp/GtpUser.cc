@@ -22,6 +22,9 @@ void GtpUser::initialize(int stage)
         return;
     localPort_ = par("localPort");
 
+    trafficFlowFilterGateId_ = gate("trafficFlowFilterGate")->getId();
+    udpInGateId_ = gate("udpIn")->getId();
+
     socket_.setOutputGate(gate("udpOut"));
     socket_.bind(localPort_);
 
@@ -47,14 +50,15 @@ void GtpUser::initialize(int stage)
 
 void GtpUser::handleMessage(cMessage *msg)
 {
-    if (strcmp(msg->getArrivalGate()->getFullName(), "trafficFlowFilterGate") == 0)
+    int gateId = msg->getArrivalGateId();
+    if (gateId == trafficFlowFilterGateId_)
     {
         EV << "GtpUser::handleMessage - message from trafficFlowFilter" << endl;
         // obtain the encapsulated IPv4 datagram
         IPv4Datagram * datagram = check_and_cast<IPv4Datagram*>(msg);
         handleFromTrafficFlowFilter(datagram);
     }
-    else if(strcmp(msg->getArrivalGate()->getFullName(),"udpIn")==0)
+    else if (gateId == udpInGateId_)
     {
         EV << "GtpUser::handleMessage - message from udp layer" << endl;
 
@@ -76,19 +80,17 @@ void GtpUser::handleFromTrafficFlowFilter(IPv4Datagram * datagram)
     L3Address tunnelPeerAddress;
 
     // search a correspondence between the flow id and the pair <teid,nextHop>
-    LabelTable::iterator tftIt;
-    tftIt = tftTable_.find(flowId);
-    if (tftIt == tftTable_.end())
+    const ConnectionInfo* flowInfo = tftTable_.find(flowId);
+    if (flowInfo == NULL)
     {
         EV << "GtpUser::handleFromTrafficFlowFilter - Cannot find entry for TFT " << flowId << ". Discarding packet;" << endl;
         return;
     }
-    tunnelPeerAddress = tftIt->second.nextHop;
-    nextTeid = tftIt->second.teid;
+    tunnelPeerAddress = flowInfo->nextHop;
+    nextTeid = flowInfo->teid;
 
     // create a new gtpUserMessage
-    GtpUserMsg * gtpMsg = new GtpUserMsg();
-    gtpMsg->setName("gtpUserMessage");
+    GtpUserMsg * gtpMsg = new GtpUserMsg("gtpUserMessage");
 
     // assign the nextTeid
     gtpMsg->setTeid(nextTeid);
@@ -108,16 +110,15 @@ void GtpUser::handleFromUdp(GtpUserMsg * gtpMsg)
     oldTeid = gtpMsg->getTeid();
 
     // obtain "ConnectionInfo" from the teidTable
-    LabelTable::iterator teidIt = teidTable_.find(oldTeid);
-    if (teidIt == teidTable_.end())
+    const ConnectionInfo* teidInfo = teidTable_.find(oldTeid);
+    if (teidInfo == NULL)
     {
         EV << "GtpUser::handleFromUdp - Cannot find entry for TEID " << oldTeid << ". Discarding packet;" << endl;
         return;
     }
-    ConnectionInfo teidInfo = teidIt->second;
 
     // decide here whether performing a label switching or a label removal
-    if (teidInfo.teid == LOCAL_ADDRESS_TEID) // tunneling ended.
+    if (teidInfo->teid == LOCAL_ADDRESS_TEID) // tunneling ended.
     {
         EV << "GtpUser::handleFromUdp - IP packet pointing to this network. Decapsulating and sending to local connection." << endl;
 
@@ -128,12 +129,12 @@ void GtpUser::handleFromUdp(GtpUserMsg * gtpMsg)
     }
     else // label switching
     {
-        EV << "GtpUser::handleFromUdp - performing label switching: [" << oldTeid << "]->[" << teidInfo.teid
-           << "] - nextHop[" << teidInfo.nextHop << "]." << endl;
+        EV << "GtpUser::handleFromUdp - performing label switching: [" << oldTeid << "]->[" << teidInfo->teid
+           << "] - nextHop[" << teidInfo->nextHop << "]." << endl;
         // in case of label switching, send the packet to the next tunnel
-        gtpMsg->setTeid(teidInfo.teid);
-        gtpMsg->removeControlInfo();
-        socket_.sendTo(gtpMsg,teidInfo.nextHop,tunnelPeerPort_);
+        gtpMsg->setTeid(teidInfo->teid);
+        delete gtpMsg->removeControlInfo();
+        socket_.sendTo(gtpMsg,teidInfo->nextHop,tunnelPeerPort_);
     }
 }
 
@@ -191,10 +192,8 @@ bool GtpUser::loadTeidTable(const char * teidTableFile)
             teidOut = atoi(temp[1]);
             nextHop.set(IPv4Address(temp[2]));
 
-            std::pair<LabelTable::iterator,bool> ret;
-            ret = teidTable_.insert(std::pair<TunnelEndpointIdentifier,ConnectionInfo>(teidIn,ConnectionInfo(teidOut,nextHop)));;
-            if (ret.second==false)
-            EV << "GtpUser::loadTeidTable - skipping duplicate entry  with TEID " << ret.first->first << '\n';
+            if (!teidTable_.insert(teidIn,ConnectionInfo(teidOut,nextHop)))
+            EV << "GtpUser::loadTeidTable - skipping duplicate entry  with TEID " << teidIn << '\n';
             else
             EV << "GtpUser::loadTeidTable - inserted entry: TEIDin[" << teidIn << "] - TEIDout[" << teidOut << "] - NextHop[" << nextHop << "]" << endl;
         }
@@ -259,10 +258,8 @@ bool GtpUser::loadTftTable(const char * tftTableFile)
             nextHop.set(IPv4Address(temp[2]));
 
             // create a new entry in the TEID table,
-            std::pair<LabelTable::iterator,bool> ret;
-            ret = tftTable_.insert(std::pair<TrafficFlowTemplateId,ConnectionInfo>(tft,ConnectionInfo(teidOut,nextHop)));;
-            if (ret.second==false)
-            EV << "GtpUser::loadTftTable - skipping duplicate entry  with TFT " << ret.first->first << '\n';
+            if (!tftTable_.insert(tft,ConnectionInfo(teidOut,nextHop)))
+            EV << "GtpUser::loadTftTable - skipping duplicate entry  with TFT " << tft << '\n';
             else
             EV << "GtpUser::loadTtftTable - inserted entry: TFT[" << tft << "] - TEIDout[" << teidOut << "] - NextHop[" << nextHop << "]" << endl;
         }
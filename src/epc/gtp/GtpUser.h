@@ -77,17 +77,21 @@ class GtpUser : public cSimpleModule
      * - if nextTEID==LOCAL_ADDRESS_TEID decapsulate the packet and forward it towards its original destination
      * - if nextTEID>0 then update the TEID value of the incoming packet with nextTEID and then forward it to nextHop
      */
-    LabelTable teidTable_;
+    LabelVector teidTable_;
 
     /*
      * This table contains mapping between TrafficFlowTemplate (TFT) identifiers and <nextTEID,nextHop>
      * TFT are set by the traffic filter in the P-GW and UE
      */
-    LabelTable tftTable_;
+    LabelVector tftTable_;
 
     // the GTP protocol Port
     unsigned int tunnelPeerPort_;
 
+    // IDs of the input gates, used to dispatch incoming messages
+    int trafficFlowFilterGateId_;
+    int udpInGateId_;
+
     bool loadTeidTable(const char * teidTableFile);
     bool loadTftTable(const char * tftTableFile);
 
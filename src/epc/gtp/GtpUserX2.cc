@@ -25,6 +25,9 @@ void GtpUserX2::initialize(int stage)
     // get reference to the binder
     binder_ = getBinder();
 
+    lteStackInGateId_ = gate("lteStackIn")->getId();
+    udpInGateId_ = gate("udpIn")->getId();
+
     socket_.setOutputGate(gate("udpOut"));
     socket_.bind(localPort_);
 
@@ -33,7 +36,8 @@ void GtpUserX2::initialize(int stage)
 
 void GtpUserX2::handleMessage(cMessage *msg)
 {
-    if (strcmp(msg->getArrivalGate()->getFullName(), "lteStackIn") == 0)
+    int gateId = msg->getArrivalGateId();
+    if (gateId == lteStackInGateId_)
     {
         EV << "GtpUserX2::handleMessage - message from X2 Manager" << endl;
 
@@ -41,7 +45,7 @@ void GtpUserX2::handleMessage(cMessage *msg)
         LteX2Message* x2Msg = check_and_cast<LteX2Message*>(msg);
         handleFromStack(x2Msg);
     }
-    else if(strcmp(msg->getArrivalGate()->getFullName(),"udpIn")==0)
+    else if (gateId == udpInGateId_)
     {
         EV << "GtpUserX2::handleMessage - message from udp layer" << endl;
 
@@ -58,8 +62,7 @@ void GtpUserX2::handleFromStack(LteX2Message* x2Msg)
     EV << "GtpUserX2::handleFromStack - Received a LteX2Message with destId[" << destId << "]" << endl;
 
     // create a new GtpUserMessage
-    GtpUserMsg * gtpMsg = new GtpUserMsg();
-    gtpMsg->setName("GtpUserMessage");
+    GtpUserMsg * gtpMsg = new GtpUserMsg("GtpUserMessage");
 
     // encapsulate the datagram within the GtpUserX2Message
     gtpMsg->encapsulate(x2Msg);
@@ -36,6 +36,10 @@ class GtpUserX2 : public cSimpleModule
     // the GTP protocol Port
     unsigned int tunnelPeerPort_;
 
+    // IDs of the input gates, used to dispatch incoming messages
+    int lteStackInGateId_;
+    int udpInGateId_;
+
   protected:
 
     virtual int numInitStages() const { return inet::NUM_INIT_STAGES; }
@@ -9,6 +9,24 @@
 
 #include "epc/gtp_common.h"
 
+bool LabelVector::insert(int label, const ConnectionInfo& info)
+{
+    if (label < 0 || label > MAX_DENSE_LABEL)
+        return overflow_.insert(std::pair<int, ConnectionInfo>(label, info)).second;
+
+    if (label >= (int)valid_.size())
+    {
+        entries_.resize(label + 1, ConnectionInfo(LOCAL_ADDRESS_TEID, L3Address()));
+        valid_.resize(label + 1, false);
+    }
+    else if (valid_[label])
+        return false;
+
+    entries_[label] = info;
+    valid_[label] = true;
+    return true;
+}
+
 // TODO use this function as a basis for general xml reading
 char * const * loadXmlTable(char const * attributes[], unsigned int numAttributes)
 {
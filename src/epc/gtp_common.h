@@ -12,6 +12,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include "inet/networklayer/common/L3Address.h"
 
 using namespace inet;
@@ -44,6 +45,40 @@ struct ConnectionInfo
 };
 
 typedef std::map<TunnelEndpointIdentifier, ConnectionInfo> LabelTable;
+
+/// Largest label stored in the dense part of a LabelVector
+#define MAX_DENSE_LABEL 65535
+
+/**
+ * Label table for the per-packet path of the GTP-U entities.
+ * TEIDs and TFT identifiers are small non-negative integers assigned by configuration,
+ * so entries are kept in a vector indexed by the label itself. Labels outside
+ * [0, MAX_DENSE_LABEL] are kept in a LabelTable.
+ */
+class LabelVector
+{
+    std::vector<ConnectionInfo> entries_;
+    std::vector<bool> valid_;
+    LabelTable overflow_;
+
+  public:
+    /**
+     * Adds the entry for the given label
+     * @return false if the label was already present (the entry is not modified)
+     */
+    bool insert(int label, const ConnectionInfo& info);
+
+    /// returns the entry for the given label, NULL if not present
+    const ConnectionInfo* find(int label) const
+    {
+        if (label >= 0 && label < (int)valid_.size())
+            return valid_[label] ? &entries_[label] : NULL;
+        if (overflow_.empty())
+            return NULL;
+        LabelTable::const_iterator it = overflow_.find(label);
+        return (it == overflow_.end()) ? NULL : &(it->second);
+    }
+};
 //===================================================================
 
 //=================== Traffic filters management ====================
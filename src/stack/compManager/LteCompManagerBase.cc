@@ -120,6 +120,14 @@ void LteCompManagerBase::runCoordinatorOperations()
     EV << "LteCompManagerBase::runCoordinatorOperations - node " << nodeId_ << endl;
     doCoordination();
 
+    X2CompReplyIE* multicastReplyIe = buildCoordinatorMulticastReply();
+    if (multicastReplyIe != NULL)
+    {
+        // a single reply for all the clients
+        sendCoordinatorMulticastReply(multicastReplyIe);
+        return;
+    }
+
     // for each client, send the appropriate reply
     std::vector<X2NodeId>::iterator cit = clientList_.begin();
     for (; cit != clientList_.end(); ++cit)
@@ -216,6 +224,41 @@ void LteCompManagerBase::sendCoordinatorReply(X2NodeId clientId, X2CompReplyIE*
     }
 }
 
+void LteCompManagerBase::sendCoordinatorMulticastReply(X2CompReplyIE* replyIe)
+{
+    // the local client (if any) gets its own copy of the reply
+    X2CompReplyIE* localReplyIe = NULL;
+    if (nodeType_ == COMP_CLIENT_COORDINATOR)
+        localReplyIe = replyIe->dup();
+
+    if (!clientList_.empty())
+    {
+        // build control info
+        X2ControlInfo* ctrlInfo = new X2ControlInfo();
+        ctrlInfo->setSourceId(nodeId_);
+        DestinationIdList destList(clientList_.begin(), clientList_.end());
+        ctrlInfo->setDestIdList(destList);
+
+        // build X2 Comp Msg
+        X2CompMsg* compMsg = new X2CompMsg("X2CompMsg");
+        compMsg->pushIe(replyIe);
+        compMsg->setControlInfo(ctrlInfo);
+
+        // send to X2 Manager, which delivers a copy to each client
+        send(PK(compMsg),x2Manager_[OUT]);
+    }
+    else
+        delete replyIe;
+
+    if (localReplyIe != NULL)
+    {
+        X2CompMsg* compMsg = new X2CompMsg("X2CompMsg");
+        compMsg->pushIe(localReplyIe);
+        compMsg->setSourceId(nodeId_);
+        handleCoordinatorReply(compMsg);
+        delete compMsg;
+    }
+}
 
 void LteCompManagerBase::setUsableBands(UsableBands& usableBands)
 {
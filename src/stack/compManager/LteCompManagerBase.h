@@ -74,6 +74,7 @@ protected:
     void handleX2Message(cPacket* pkt);
     void sendClientRequest(X2CompRequestIE* requestIe);
     void sendCoordinatorReply(X2NodeId clientId, X2CompReplyIE* replyIe);
+    void sendCoordinatorMulticastReply(X2CompReplyIE* replyIe);
 
     virtual void provisionalSchedule() = 0;  // run the provisional scheduling algorithm (client side)
     virtual void doCoordination() = 0;       // run the coordination algorithm (coordinator side)
@@ -82,6 +83,8 @@ protected:
     virtual void handleClientRequest(X2CompMsg* compMsg) = 0;
 
     virtual X2CompReplyIE* buildCoordinatorReply(X2NodeId clientId) = 0;
+    // reply for all the clients, sent with a single X2 message (NULL if not supported)
+    virtual X2CompReplyIE* buildCoordinatorMulticastReply() { return NULL; }
     virtual void handleCoordinatorReply(X2CompMsg* compMsg) = 0;
 
     void setUsableBands(UsableBands& usableBands);
@@ -8,12 +8,28 @@
 //
 
 #include "stack/compManager/compManagerProportional/LteCompManagerProportional.h"
+#include <algorithm>
 
 Define_Module(LteCompManagerProportional);
 
+namespace {
+// orders the indexes of a vector by ascending value of the corresponding elements
+struct IndexLess
+{
+    const std::vector<double>& vec_;
+    IndexLess(const std::vector<double>& vec) : vec_(vec) {}
+    bool operator()(unsigned int a, unsigned int b) const { return vec_[a] < vec_[b]; }
+};
+}
+
 void LteCompManagerProportional::initialize()
 {
     LteCompManagerBase::initialize();
+
+    reqChanged_ = false;
+    hasAllocation_ = false;
+    allocFirstBand_ = 0;
+    allocNumBands_ = 0;
 }
 
 void LteCompManagerProportional::provisionalSchedule()
@@ -59,46 +75,39 @@ void LteCompManagerProportional::doCoordination()
 {
     EV << NOW << " LteCompManagerProportional::doCoordination - Start " << endl;
 
-    partitioning_.clear();
-    offset_.clear();
+    // the partitioning only depends on the requests
+    if (!reqChanged_)
+    {
+        EV << NOW << " LteCompManagerProportional::doCoordination - Requests unchanged, keep the previous partitioning " << endl;
+        return;
+    }
+    reqChanged_ = false;
 
+    unsigned int numClients = reqBlocks_.size();
     unsigned int requestsSum = 0;
-    std::map<X2NodeId, unsigned int>::iterator it = reqBlocksMap_.begin();
-    for (; it != reqBlocksMap_.end(); ++it)
-        requestsSum += it->second;
+    for (unsigned int i = 0; i < numClients; i++)
+        requestsSum += reqBlocks_[i];
 
     // assign a number of blocks that is proportional to the requests received from each eNB
-    unsigned int totalReservedBlocks = 0;
-    std::vector<double> reservation;
-    reservation.clear();
-    for (it = reqBlocksMap_.begin(); it != reqBlocksMap_.end(); ++it)
+    reservation_.resize(numClients);
+    for (unsigned int i = 0; i < numClients; i++)
     {
-
-
-        // requests from the current node
-        unsigned int req = it->second;
-
         // compute the number of blocks to reserve
         double percentage;
         if (requestsSum == 0)
             percentage = 1.0 / (clientList_.size() + 1);  // slaves + master
         else
-            percentage = (double) req / requestsSum;
+            percentage = (double) reqBlocks_[i] / requestsSum;
 
-        double toReserve = numBands_ * percentage;
-        totalReservedBlocks += toReserve;
-
-        reservation.push_back(toReserve);
+        reservation_[i] = numBands_ * percentage;
     }
 
     // round vector to integer
-    partitioning_ = roundVector(reservation, totalReservedBlocks);
+    roundVector(reservation_, partitioning_);
 
-    offset_.push_back(0);
-    for (unsigned int i=0; i < partitioning_.size() - 1; i++)
-    {
-        offset_.push_back(partitioning_[i]);
-    }
+    offset_.resize(numClients);
+    for (unsigned int i = 0; i < numClients; i++)
+        offset_[i] = (i == 0) ? 0 : partitioning_[i - 1];
 
     EV << NOW << " LteCompManagerProportional::doCoordination - End " << endl;
 }
@@ -112,25 +121,22 @@ X2CompProportionalRequestIE* LteCompManagerProportional::buildClientRequest()
     return requestIe;
 }
 
+int LteCompManagerProportional::getClientIndex(X2NodeId clientId) const
+{
+    std::vector<X2NodeId>::const_iterator it = std::lower_bound(reqNodes_.begin(), reqNodes_.end(), clientId);
+    if (it == reqNodes_.end() || *it != clientId)
+        return -1;
+    return it - reqNodes_.begin();
+}
+
 X2CompProportionalReplyIE* LteCompManagerProportional::buildCoordinatorReply(X2NodeId clientId)
 {
     // find the correct entry in the partitioning vector
-    bool found = false;
-    unsigned int index = 0;
-    std::map<X2NodeId, unsigned int>::iterator it = reqBlocksMap_.begin();
-    for (; it != reqBlocksMap_.end(); ++it)
-    {
-        if (it->first == clientId)
-        {
-            found = true;
-            break;
-        }
-        index++;
-    }
+    int index = getClientIndex(clientId);
 
     unsigned int numBlocks = 0;
     unsigned int band = 0;
-    if (found)
+    if (index >= 0)
     {
         numBlocks = partitioning_[index];
         band = offset_[index];
@@ -140,15 +146,11 @@ X2CompProportionalReplyIE* LteCompManagerProportional::buildCoordinatorReply(X2N
     std::vector<CompRbStatus> allowedBlocks;
 
     // set "numBlocks" contiguous blocks for this node
-    allowedBlocks.clear();
     allowedBlocks.resize(numBands_, NOT_AVAILABLE_RB);
     unsigned int lb = band;
-    unsigned int ub = band + numBlocks;
+    unsigned int ub = std::min(band + numBlocks, (unsigned int) numBands_);
     for (unsigned int b = lb; b < ub; b++)
-    {
         allowedBlocks[b] = AVAILABLE_RB;
-        band++;
-    }
 
     // build IE
     X2CompProportionalReplyIE* replyIe = new X2CompProportionalReplyIE();
@@ -157,6 +159,16 @@ X2CompProportionalReplyIE* LteCompManagerProportional::buildCoordinatorReply(X2N
     return replyIe;
 }
 
+X2CompProportionalMulticastReplyIE* LteCompManagerProportional::buildCoordinatorMulticastReply()
+{
+    // the allocation of every client, in the same order as reqNodes_
+    X2CompProportionalMulticastReplyIE* replyIe = new X2CompProportionalMulticastReplyIE();
+    for (unsigned int i = 0; i < reqNodes_.size(); i++)
+        replyIe->addClient(reqNodes_[i], offset_[i], partitioning_[i]);
+
+    return replyIe;
+}
+
 void LteCompManagerProportional::handleClientRequest(X2CompMsg* compMsg)
 {
     X2NodeId sourceId = compMsg->getSourceId();
@@ -169,11 +181,20 @@ void LteCompManagerProportional::handleClientRequest(X2CompMsg* compMsg)
         X2CompProportionalRequestIE* requestIe = check_and_cast<X2CompProportionalRequestIE*>(ie);
         unsigned int reqBlocks = requestIe->getNumBlocks();
 
-        // update map entry for this node
-        if (reqBlocksMap_.find(sourceId) == reqBlocksMap_.end())
-            reqBlocksMap_.insert(std::pair<X2NodeId, unsigned int>(sourceId, reqBlocks));
-        else
-            reqBlocksMap_[sourceId] = reqBlocks;
+        // update the entry for this node
+        std::vector<X2NodeId>::iterator it = std::lower_bound(reqNodes_.begin(), reqNodes_.end(), sourceId);
+        unsigned int index = it - reqNodes_.begin();
+        if (it == reqNodes_.end() || *it != sourceId)
+        {
+            reqNodes_.insert(it, sourceId);
+            reqBlocks_.insert(reqBlocks_.begin() + index, reqBlocks);
+            reqChanged_ = true;
+        }
+        else if (reqBlocks_[index] != reqBlocks)
+        {
+            reqBlocks_[index] = reqBlocks;
+            reqChanged_ = true;
+        }
 
         delete requestIe;
     }
@@ -189,14 +210,46 @@ void LteCompManagerProportional::handleCoordinatorReply(X2CompMsg* compMsg)
                     "LteCompManagerProportional::handleCoordinatorReply - Expected COMP_REPLY_IE");
 
         // parse reply message
+        X2CompProportionalMulticastReplyIE* multicastReplyIe = dynamic_cast<X2CompProportionalMulticastReplyIE*>(ie);
+        if (multicastReplyIe != NULL)
+        {
+            // no allocation for this node means no usable bands
+            unsigned int firstBand = 0, numBands = 0;
+            multicastReplyIe->getAllocation(nodeId_, firstBand, numBands);
+            setAllocation(firstBand, numBands);
+        }
+        else
+        {
+            X2CompProportionalReplyIE* replyIe = check_and_cast<X2CompProportionalReplyIE*>(ie);
+            std::vector<CompRbStatus>& allowedBlocksMap = replyIe->getAllowedBlocksMap();
+            UsableBands usableBands = parseAllowedBlocksMap(allowedBlocksMap);
+            setUsableBands(usableBands);
+            hasAllocation_ = false;
+        }
+
+        delete ie;
+    }
+}
 
-        X2CompProportionalReplyIE* replyIe = check_and_cast<X2CompProportionalReplyIE*>(ie);
-        std::vector<CompRbStatus> allowedBlocksMap = replyIe->getAllowedBlocksMap();
-        UsableBands usableBands = parseAllowedBlocksMap(allowedBlocksMap);
+void LteCompManagerProportional::setAllocation(unsigned int firstBand, unsigned int numBands)
+{
+    unsigned int ub = std::min(firstBand + numBands, (unsigned int) numBands_);
+    unsigned int reservedBlocks = (ub > firstBand) ? ub - firstBand : 0;
+
+    // the usable bands are rebuilt only when the allocation changes
+    if (!hasAllocation_ || firstBand != allocFirstBand_ || numBands != allocNumBands_)
+    {
+        UsableBands usableBands;
+        for (unsigned int b = firstBand; b < ub; b++)
+            usableBands.push_back(b);
         setUsableBands(usableBands);
 
-        delete replyIe;
+        hasAllocation_ = true;
+        allocFirstBand_ = firstBand;
+        allocNumBands_ = numBands;
     }
+
+    emit(compReservedBlocks_, reservedBlocks);
 }
 
 UsableBands LteCompManagerProportional::parseAllowedBlocksMap(std::vector<CompRbStatus>& allowedBlocksMap)
@@ -218,67 +271,28 @@ UsableBands LteCompManagerProportional::parseAllowedBlocksMap(std::vector<CompRb
     return usableBands;
 }
 
-std::vector<unsigned int> LteCompManagerProportional::roundVector(std::vector<double>& vec, int sum)
+void LteCompManagerProportional::roundVector(const std::vector<double>& vec, std::vector<unsigned int>& integerVec)
 {
     // the rounding algorithm needs that the vector is sorted in ascending order
 
-    // we sort the vector, then put the elements in the original order
-    // to do this, we use an auxiliary vector to remember the original positions
-
+    // we visit the elements through a vector of indexes sorted by ascending value
+    // (stable, so that equal elements keep their original order)
     unsigned int len = vec.size();
-    std::vector<unsigned int> integerVec;
-    integerVec.resize(len, 0);
-
-    if (len > 0)
+    integerVec.assign(len, 0);
+    sortedIndex_.resize(len);
+    for (unsigned int i = 0; i < len; i++)
+        sortedIndex_[i] = i;
+    std::stable_sort(sortedIndex_.begin(), sortedIndex_.end(), IndexLess(vec));
+
+    // round vector (the sum of the elements is preserved)
+    int integerTot = 0;
+    double doubleTot = 0;
+    for (unsigned int i = 0; i < len; i++)
     {
-        // auxiliary vector
-        std::vector<unsigned int> auxVec;
-        auxVec.resize(len, 0);
-        for (unsigned int i = 0; i < auxVec.size(); i++)
-            auxVec[i] = i;
-
-        // sort vector in ascending order
-        bool swap = true;
-        while (swap)
-        {
-            swap = false;
-            for (unsigned int i = 0; i < len - 1; i++)
-            {
-                if (vec[i] > vec[i + 1])
-                {
-                    double tmp = vec[i + 1];
-                    vec[i + 1] = vec[i];
-                    vec[i] = tmp;
-
-                    unsigned int auxTmp = auxVec[i + 1];
-                    auxVec[i + 1] = auxVec[i];
-                    auxVec[i] = auxTmp;
-
-                    swap = true;
-                }
-            }
-        }
-
-        // round vector (the sum of the elements is preserved)
-        int integerTot = 0;
-        double doubleTot = 0;
-        for (unsigned int i = 0; i < len; i++)
-        {
-            doubleTot += vec[i];
-            vec[i] = (int) (doubleTot - integerTot);
-            integerTot += vec[i];
-        }
-
-        // TODO -  check numerical errors
-    //    if (integerTot < sum)
-    //        vec[len-1]++;
-
-        // set the integer vector with the elements in their original positions
-        for (unsigned int i = 0; i < integerVec.size(); i++)
-        {
-            unsigned int index = auxVec[i];
-            integerVec[index] = vec[i];
-        }
+        unsigned int index = sortedIndex_[i];
+        doubleTot += vec[index];
+        int value = (int) (doubleTot - integerTot);
+        integerTot += value;
+        integerVec[index] = value;
     }
-    return integerVec;
 }
@@ -13,6 +13,7 @@
 #include "stack/compManager/LteCompManagerBase.h"
 #include "stack/compManager/compManagerProportional/X2CompProportionalRequestIE.h"
 #include "stack/compManager/compManagerProportional/X2CompProportionalReplyIE.h"
+#include "stack/compManager/compManagerProportional/X2CompProportionalMulticastReplyIE.h"
 
 class LteCompManagerProportional : public LteCompManagerBase {
 
@@ -27,14 +28,35 @@ protected:
     /*
      * Coordinator info
      */
-    // requests from clients
-    std::map<X2NodeId, unsigned int> reqBlocksMap_;
+    // requests from clients, in ascending order of X2NodeId
+    // (the i-th entry of the partitioning refers to the i-th client)
+    std::vector<X2NodeId> reqNodes_;
+    std::vector<unsigned int> reqBlocks_;
+    // true if some request changed since the last coordination
+    bool reqChanged_;
     // frame partitioning
     std::vector<unsigned int> partitioning_;
     std::vector<unsigned int> offset_;
+    // buffers reused by doCoordination()
+    std::vector<double> reservation_;
+    std::vector<unsigned int> sortedIndex_;
+
+    /*
+     * Client info
+     */
+    // last allocation received from the coordinator
+    bool hasAllocation_;
+    unsigned int allocFirstBand_;
+    unsigned int allocNumBands_;
 
     // utility function: convert a vector of double to a vector of integer, preserving the sum of the elements
-    std::vector<unsigned int> roundVector(std::vector<double>& vec, int sum);
+    void roundVector(const std::vector<double>& vec, std::vector<unsigned int>& integerVec);
+
+    // index of the given client in reqNodes_, -1 if it never sent a request
+    int getClientIndex(X2NodeId clientId) const;
+
+    // applies the given contiguous allocation as usable bands
+    void setAllocation(unsigned int firstBand, unsigned int numBands);
 
     virtual void provisionalSchedule();  // run the provisional scheduling algorithm (client side)
     virtual void doCoordination();       // run the coordination algorithm (coordinator side)
@@ -43,6 +65,7 @@ protected:
     virtual void handleClientRequest(X2CompMsg* compMsg);
 
     virtual X2CompProportionalReplyIE* buildCoordinatorReply(X2NodeId clientId);
+    virtual X2CompProportionalMulticastReplyIE* buildCoordinatorMulticastReply();
     virtual void handleCoordinatorReply(X2CompMsg* compMsg);
 
     UsableBands parseAllowedBlocksMap(std::vector<CompRbStatus>& allowedBlocksMap);
@@ -0,0 +1,81 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+
+#ifndef _LTE_X2COMPPROPORTIONALMULTICASTREPLYIE_H_
+#define _LTE_X2COMPPROPORTIONALMULTICASTREPLYIE_H_
+
+#include <algorithm>
+#include "stack/compManager/X2CompReplyIE.h"
+
+//
+// Reply of the proportional coordinator for all its clients, sent with a single
+// X2 message. For each client it carries the range of contiguous bands the client
+// is allowed to use
+//
+class X2CompProportionalMulticastReplyIE : public X2CompReplyIE
+{
+  protected:
+
+    // clients, in ascending order of X2NodeId
+    std::vector<X2NodeId> clients_;
+    // first allowed band and number of allowed bands of each client
+    std::vector<unsigned int> firstBand_;
+    std::vector<unsigned int> numBands_;
+
+  public:
+    X2CompProportionalMulticastReplyIE()
+    {
+        length_ = 0;
+    }
+    X2CompProportionalMulticastReplyIE(const X2CompProportionalMulticastReplyIE& other) :
+        X2CompReplyIE()
+    {
+        operator=(other);
+    }
+
+    X2CompProportionalMulticastReplyIE& operator=(const X2CompProportionalMulticastReplyIE& other)
+    {
+        if (&other == this)
+            return *this;
+        clients_ = other.clients_;
+        firstBand_ = other.firstBand_;
+        numBands_ = other.numBands_;
+        X2InformationElement::operator=(other);
+        return *this;
+    }
+    virtual X2CompProportionalMulticastReplyIE *dup() const
+    {
+        return new X2CompProportionalMulticastReplyIE(*this);
+    }
+    virtual ~X2CompProportionalMulticastReplyIE() {}
+
+    // clients must be added in ascending order of X2NodeId
+    void addClient(X2NodeId clientId, unsigned int firstBand, unsigned int numBands)
+    {
+        clients_.push_back(clientId);
+        firstBand_.push_back(firstBand);
+        numBands_.push_back(numBands);
+        length_ += sizeof(X2NodeId) + 2 * sizeof(unsigned int);
+    }
+
+    // returns false if the reply carries no allocation for the given client
+    bool getAllocation(X2NodeId clientId, unsigned int& firstBand, unsigned int& numBands) const
+    {
+        std::vector<X2NodeId>::const_iterator it = std::lower_bound(clients_.begin(), clients_.end(), clientId);
+        if (it == clients_.end() || *it != clientId)
+            return false;
+        unsigned int index = it - clients_.begin();
+        firstBand = firstBand_[index];
+        numBands = numBands_[index];
+        return true;
+    }
+};
+
+#endif
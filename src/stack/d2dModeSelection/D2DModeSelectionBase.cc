@@ -22,6 +22,10 @@ void D2DModeSelectionBase::initialize(int stage)
 
     // get reference to mac layer
     mac_ = check_and_cast<LteMacEnb*>(getParentModule()->getSubmodule("mac"));
+    if (strcmp(mac_->getClassName(), "LteMacEnbD2D") == 0)
+        macD2D_ = check_and_cast<LteMacEnbD2D*>(mac_);
+    else if (strcmp(mac_->getClassName(), "LteMacEnbRealisticD2D") == 0)
+        macRealisticD2D_ = check_and_cast<LteMacEnbRealisticD2D*>(mac_);
 
     // get reference to the binder
     binder_ = getBinder();
@@ -62,6 +66,69 @@ void D2DModeSelectionBase::handleMessage(cMessage *msg)
     }
 }
 
+void D2DModeSelectionBase::refreshPeerings()
+{
+    if (peerings_.size() == binder_->getNumD2DPeerings())
+        return;
+
+    peerings_.clear();
+    srcPeerings_.clear();
+    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = peeringModeMap_->begin();
+    for (; it != peeringModeMap_->end(); ++it)
+    {
+        MacNodeId srcId = it->first;
+        if (srcId < UE_MIN_ID || it->second.empty())
+            continue;
+
+        unsigned int index = srcId - UE_MIN_ID;
+        if (index >= srcPeerings_.size())
+            srcPeerings_.resize(index + 1, std::pair<unsigned int, unsigned int>(0, 0));
+        srcPeerings_[index] = std::pair<unsigned int, unsigned int>(peerings_.size(), it->second.size());
+
+        std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
+        for (; jt != it->second.end(); ++jt)
+        {
+            Peering peering;
+            peering.src = srcId;
+            peering.dst = jt->first;
+            peering.mode = &(jt->second);
+            peerings_.push_back(peering);
+        }
+
+        // new peerings may need a different mode
+        pendingUes_.insert(srcId);
+    }
+}
+
+void D2DModeSelectionBase::updatePendingUes()
+{
+    refreshPeerings();
+    mac_->getAmc()->takeUpdatedUes(pendingUes_);
+}
+
+void D2DModeSelectionBase::markPeeringsOf(MacNodeId nodeId)
+{
+    std::vector<Peering>::iterator it = peerings_.begin();
+    for (; it != peerings_.end(); ++it)
+    {
+        if (it->src == nodeId || it->dst == nodeId)
+            pendingUes_.insert(it->src);
+    }
+}
+
+void D2DModeSelectionBase::addSwitch(Peering& peering, LteD2DMode newMode)
+{
+    FlowId p(peering.src, peering.dst);
+    FlowModeInfo info;
+    info.flow = p;
+    info.oldMode = *(peering.mode);
+    info.newMode = newMode;
+    switchList_.push_back(info);
+
+    // update peering map
+    *(peering.mode) = newMode;
+}
+
 void D2DModeSelectionBase::doModeSwitchAtHandover(MacNodeId nodeId, bool handoverCompleted)
 {
     EV << NOW << " D2DModeSelectionBase::doModeSwitchAtHandover - Force mode switching for UE " << nodeId << " (handover)" << endl;
@@ -72,51 +139,44 @@ void D2DModeSelectionBase::doModeSwitchAtHandover(MacNodeId nodeId, bool handove
     else
         newMode = IM;
 
+    refreshPeerings();
+
     switchList_.clear();
-    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = peeringModeMap_->begin();
-    for (; it != peeringModeMap_->end(); ++it)
+    std::vector<Peering>::iterator it = peerings_.begin();
+    for (; it != peerings_.end(); ++it)
     {
-        MacNodeId srcId = it->first;
-        std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
-        for (; jt != it->second.end(); ++jt)
-        {
-            MacNodeId dstId = jt->first;
-            if (srcId != nodeId && dstId != nodeId)
-                continue;
-
-            LteD2DMode oldMode = jt->second;
-            if (oldMode == newMode)
-                continue;
-
-            // check if the two peers are under the same cell
-            // if not, do not perform the switch
-            if (newMode == DM && binder_->getNextHop(srcId) != binder_->getNextHop(dstId))
-                continue;
-
-            // add this flow to the list of flows to be switched
-            FlowId p(srcId, dstId);
-            FlowModeInfo info;
-            info.flow = p;
-            info.oldMode = oldMode;
-            info.newMode = newMode;
-            switchList_.push_back(info);
-
-            // update peering map
-            jt->second = newMode;
-
-            std::cout << NOW << " D2DModeSelectionBase::doModeSwitchAtHandover - Flow: " << srcId << " --> " << dstId << " [" << d2dModeToA(newMode) << "]" << endl;
-        }
+        MacNodeId srcId = it->src;
+        MacNodeId dstId = it->dst;
+        if (srcId != nodeId && dstId != nodeId)
+            continue;
+
+        LteD2DMode oldMode = *(it->mode);
+        if (oldMode == newMode)
+            continue;
+
+        // check if the two peers are under the same cell
+        // if not, do not perform the switch
+        if (newMode == DM && binder_->getNextHop(srcId) != binder_->getNextHop(dstId))
+            continue;
+
+        // add this flow to the list of flows to be switched
+        addSwitch(*it, newMode);
+
+        std::cout << NOW << " D2DModeSelectionBase::doModeSwitchAtHandover - Flow: " << srcId << " --> " << dstId << " [" << d2dModeToA(newMode) << "]" << endl;
     }
 
     // send switching command
     sendModeSwitchNotifications();
-
-    switchList_.clear();
 }
 
 
 void D2DModeSelectionBase::sendModeSwitchNotifications()
 {
+    if (switchList_.empty())
+        return;
+    if (macD2D_ == NULL && macRealisticD2D_ == NULL)
+        throw cRuntimeError("D2DModeSelectionBase::sendModeSwitchNotifications - unrecognized MAC type %s", mac_->getClassName());
+
     SwitchList::iterator it = switchList_.begin();
     for (; it != switchList_.end(); ++it)
     {
@@ -125,11 +185,10 @@ void D2DModeSelectionBase::sendModeSwitchNotifications()
         LteD2DMode oldMode = it->oldMode;
         LteD2DMode newMode = it->newMode;
 
-        if (strcmp(mac_->getClassName(), "LteMacEnbD2D") == 0)
-            check_and_cast<LteMacEnbD2D*>(mac_)->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
-        else if (strcmp(mac_->getClassName(), "LteMacEnbRealisticD2D") == 0)
-            check_and_cast<LteMacEnbRealisticD2D*>(mac_)->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
+        if (macD2D_ != NULL)
+            macD2D_->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
         else
-            throw cRuntimeError("D2DModeSelectionBase::sendModeSwitchNotifications - unrecognized MAC type %s", mac_->getClassName());
+            macRealisticD2D_->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
     }
+    switchList_.clear();
 }
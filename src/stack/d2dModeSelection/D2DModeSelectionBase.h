@@ -12,6 +12,9 @@
 
 #include "stack/mac/layer/LteMacEnb.h"
 
+class LteMacEnbD2D;
+class LteMacEnbRealisticD2D;
+
 //
 // D2DModeSelectionBase
 // Base class for D2D Mode Selection modules
@@ -36,6 +39,27 @@ protected:
     // for each D2D-capable UE, store the list of possible D2D peers and the corresponding communication mode (IM or DM)
     std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >* peeringModeMap_;
 
+    // flat copy of the peering map, sorted by transmitter. The mode points to the entry in the peering map
+    typedef struct
+    {
+        MacNodeId src;
+        MacNodeId dst;
+        LteD2DMode* mode;
+    } Peering;
+    std::vector<Peering> peerings_;
+
+    // for each transmitter (indexed by MacNodeId - UE_MIN_ID), index of its first peering in peerings_
+    // and number of peerings
+    std::vector<std::pair<unsigned int, unsigned int> > srcPeerings_;
+
+    // transmitters whose peerings must be re-evaluated at the next selection instance
+    std::set<MacNodeId> pendingUes_;
+
+    // reference to the MAC layer, if it is a LteMacEnbD2D
+    LteMacEnbD2D* macD2D_;
+    // reference to the MAC layer, if it is a LteMacEnbRealisticD2D
+    LteMacEnbRealisticD2D* macRealisticD2D_;
+
     // reference to the MAC layer
     LteMacEnb* mac_;
 
@@ -52,12 +76,38 @@ protected:
     // it must build a switch list (see above)
     virtual void doModeSelection() {}
 
+    // rebuild peerings_ if peerings have been added to the binder since the last call
+    void refreshPeerings();
+
+    // add to pendingUes_ the transmitters whose feedback changed since the last selection instance
+    void updatePendingUes();
+
+    // add to pendingUes_ the transmitters of all the peerings where nodeId is an endpoint
+    void markPeeringsOf(MacNodeId nodeId);
+
+    // get the position in peerings_ of the first peering of srcId and the number of its peerings
+    std::pair<unsigned int, unsigned int> getPeerings(MacNodeId srcId) const
+    {
+        unsigned int index = srcId - UE_MIN_ID;
+        if (srcId < UE_MIN_ID || index >= srcPeerings_.size())
+            return std::pair<unsigned int, unsigned int>(0, 0);
+        return srcPeerings_[index];
+    }
+
+    // add a flow to the switch list and update its mode in the peering map
+    void addSwitch(Peering& peering, LteD2DMode newMode);
+
     // for each pair of UEs in the switch list, send the notification to do the
-    // switch to the transmitter UE
+    // switch to the transmitter UE, then clear the list
     void sendModeSwitchNotifications();
 
 public:
-    D2DModeSelectionBase() {}
+    D2DModeSelectionBase()
+    {
+        modeSelectionTick_ = NULL;
+        macD2D_ = NULL;
+        macRealisticD2D_ = NULL;
+    }
     virtual ~D2DModeSelectionBase() {}
 
     virtual void initialize(int stage);
@@ -21,54 +21,71 @@ void D2DModeSelectionBestCqi::doModeSelection()
     EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - Running Mode Selection algorithm..." << endl;
 
     switchList_.clear();
-    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = peeringModeMap_->begin();
-    for (; it != peeringModeMap_->end(); ++it)
+
+    // re-evaluate only the transmitters whose feedback changed since the last instance
+    updatePendingUes();
+    std::set<MacNodeId> pending;
+    pending.swap(pendingUes_);
+
+    std::set<MacNodeId>::iterator it = pending.begin();
+    for (; it != pending.end(); ++it)
     {
-        MacNodeId srcId = it->first;
+        MacNodeId srcId = *it;
 
         // consider only UEs within this cell
         if (binder_->getNextHop(srcId) != mac_->getMacCellId())
             continue;
 
-        std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
-        for (; jt != it->second.end(); ++jt)
+        std::pair<unsigned int, unsigned int> range = getPeerings(srcId);
+        if (range.second == 0)
+            continue;
+
+        // skip UEs that are performing handover, they will be evaluated at the next instance
+        if (binder_->hasUeHandoverTriggered(srcId))
+        {
+            pendingUes_.insert(srcId);
+            continue;
+        }
+
+        // since the D2D CQI is the same for all D2D connections,
+        // the mode will be the same for all destinations
+        bool evaluated = false;
+        LteD2DMode newMode = IM;
+        for (unsigned int i = range.first; i < range.first + range.second; ++i)
         {
-            MacNodeId dstId = jt->first;   // since the D2D CQI is the same for all D2D connections,
-                                            // the mode will be the same for all destinations
+            Peering& peering = peerings_[i];
+            MacNodeId dstId = peering.dst;
 
             // consider only UEs within this cell
             if (binder_->getNextHop(dstId) != mac_->getMacCellId())
                 continue;
 
             // skip UEs that are performing handover
-            if (binder_->hasUeHandoverTriggered(dstId) || binder_->hasUeHandoverTriggered(srcId))
+            if (binder_->hasUeHandoverTriggered(dstId))
+            {
+                pendingUes_.insert(srcId);
                 continue;
+            }
 
-            LteD2DMode oldMode = jt->second;
-
-            // Compute the achievable bits on a single RB for UL direction
-            // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
-            // is the minimum CQI over all RBs)
-            unsigned int bitsUl = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
-            unsigned int bitsD2D = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
+            if (!evaluated)
+            {
+                // Compute the achievable bits on a single RB for UL direction
+                // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
+                // is the minimum CQI over all RBs)
+                unsigned int bitsUl = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
+                unsigned int bitsD2D = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
 
-            EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
+                EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
 
-            // compare the bits in the two modes and select the best one
-            LteD2DMode newMode = (bitsUl > bitsD2D) ? IM : DM;
+                // compare the bits in the two modes and select the best one
+                newMode = (bitsUl > bitsD2D) ? IM : DM;
+                evaluated = true;
+            }
 
-            if (newMode != oldMode)
+            if (newMode != *(peering.mode))
             {
                 // add this flow to the list of flows to be switched
-                FlowId p(srcId, dstId);
-                FlowModeInfo info;
-                info.flow = p;
-                info.oldMode = oldMode;
-                info.newMode = newMode;
-                switchList_.push_back(info);
-
-                // update peering map
-                jt->second = newMode;
+                addSwitch(peering, newMode);
 
                 EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - Flow: " << srcId << " --> " << dstId << " [" << d2dModeToA(newMode) << "]" << endl;
             }
@@ -80,9 +97,13 @@ void D2DModeSelectionBestCqi::doModeSwitchAtHandover(MacNodeId nodeId, bool hand
 {
     // with this MS algorithm, connections of nodeId will return to DM after handover only
     // if the algorithm triggers the switch at the next period. Thus, it is not necessary to
-    // force the switch here.
+    // force the switch here, but its connections must be re-evaluated at the next period.
     if (handoverCompleted)
+    {
+        refreshPeerings();
+        markPeeringsOf(nodeId);
         return;
+    }
 
     D2DModeSelectionBase::doModeSwitchAtHandover(nodeId, handoverCompleted);
 }
@@ -56,8 +56,17 @@ void LteHandoverManager::handleX2Message(cPacket* pkt)
     if (x2msg->getType() == X2_HANDOVER_DATA_MSG)
     {
         X2HandoverDataMsg* hoDataMsg = check_and_cast<X2HandoverDataMsg*>(x2msg);
-        IPv4Datagram* datagram = check_and_cast<IPv4Datagram*>(hoDataMsg->decapsulate());
-        receiveDataFromSourceEnb(datagram, sourceId);
+        if (hoDataMsg->getEncapsulatedPacket() != NULL)
+        {
+            IPv4Datagram* datagram = check_and_cast<IPv4Datagram*>(hoDataMsg->decapsulate());
+            receiveDataFromSourceEnb(datagram, sourceId);
+        }
+        // batched datagrams, in forwarding order
+        while (hoDataMsg->hasDatagrams())
+        {
+            IPv4Datagram* datagram = check_and_cast<IPv4Datagram*>(hoDataMsg->popDatagram());
+            receiveDataFromSourceEnb(datagram, sourceId);
+        }
     }
     else   // X2_HANDOVER_CONTROL_MSG
     {
@@ -133,6 +142,38 @@ void LteHandoverManager::forwardDataToTargetEnb(IPv4Datagram* datagram, MacNodeI
     send(PK(hoMsg),x2Manager_[OUT]);
 }
 
+void LteHandoverManager::forwardDataToTargetEnb(std::list<IPv4Datagram*>& datagrams, MacNodeId targetEnb)
+{
+    Enter_Method("forwardDataToTargetEnb");
+
+    // build control info
+    X2ControlInfo* ctrlInfo = new X2ControlInfo();
+    ctrlInfo->setSourceId(nodeId_);
+    DestinationIdList destList;
+    destList.push_back(targetEnb);
+    ctrlInfo->setDestIdList(destList);
+
+    // build X2 Handover Msg, moving the datagrams into it
+    X2HandoverDataMsg* hoMsg = new X2HandoverDataMsg("X2HandoverDataMsg");
+    int64_t batchLength = 0;
+    while (!datagrams.empty())
+    {
+        IPv4Datagram* datagram = datagrams.front();
+        datagrams.pop_front();
+        take(datagram);
+        batchLength += datagram->getByteLength();
+        hoMsg->pushDatagram(datagram);
+    }
+    // the message must be as long as the datagrams it carries
+    ASSERT(hoMsg->getByteLength() == batchLength);
+    hoMsg->setControlInfo(ctrlInfo);
+
+    EV<<NOW<<" LteHandoverManager::forwardDataToTargetEnb - Send " << hoMsg->getNumDatagrams() << " IP datagrams to eNB " << targetEnb << endl;
+
+    // send to X2 Manager
+    send(PK(hoMsg),x2Manager_[OUT]);
+}
+
 void LteHandoverManager::receiveDataFromSourceEnb(IPv4Datagram* datagram, MacNodeId sourceEnb)
 {
     EV<<NOW<<" LteHandoverManager::receiveDataFromSourceEnb - Received IP datagram from eNB " << sourceEnb << endl;
@@ -56,6 +56,9 @@ class LteHandoverManager : public cSimpleModule
     // send an IP datagram to the X2 Manager
     void forwardDataToTargetEnb(inet::IPv4Datagram* datagram, MacNodeId targetEnb);
 
+    // send a queue of IP datagrams to the X2 Manager within a single X2 message (the queue is emptied)
+    void forwardDataToTargetEnb(std::list<inet::IPv4Datagram*>& datagrams, MacNodeId targetEnb);
+
     // receive data from X2 message and send it to the X2 Manager
     void receiveDataFromSourceEnb(inet::IPv4Datagram* datagram, MacNodeId sourceEnb);
 };
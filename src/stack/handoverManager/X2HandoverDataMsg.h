@@ -18,9 +18,27 @@
  *
  * Class derived from LteX2Message
  * It defines the message that encapsulata datagram to be exchanged between Handover managers
+ *
+ * With batched forwarding, the message carries the whole queue of datagrams
+ * of a UE instead of a single encapsulated datagram. The datagrams are owned
+ * by the message and handed over with pushDatagram()/popDatagram(), without copies
  */
 class X2HandoverDataMsg : public LteX2Message
 {
+  protected:
+
+    /// Datagrams carried by the message (batched forwarding)
+    std::list<cPacket*> datagrams_;
+
+    void clearDatagrams()
+    {
+        while (!datagrams_.empty())
+        {
+            addBitLength(-datagrams_.front()->getBitLength());
+            dropAndDelete(datagrams_.front());
+            datagrams_.pop_front();
+        }
+    }
 
   public:
 
@@ -36,13 +54,44 @@ class X2HandoverDataMsg : public LteX2Message
     {
         if (&other == this)
             return *this;
+        clearDatagrams();
+        // the length copied from other already accounts for its datagrams
         LteX2Message::operator=(other);
+        std::list<cPacket*>::const_iterator it = other.datagrams_.begin();
+        for (; it != other.datagrams_.end(); ++it)
+        {
+            cPacket* datagram = (*it)->dup();
+            take(datagram);
+            datagrams_.push_back(datagram);
+        }
         return *this;
     }
 
     virtual X2HandoverDataMsg* dup() const { return new X2HandoverDataMsg(*this); }
 
-    virtual ~X2HandoverDataMsg() { }
+    virtual ~X2HandoverDataMsg() { clearDatagrams(); }
+
+    /// appends a datagram to the message, which becomes its owner (the message grows by its length)
+    void pushDatagram(cPacket* datagram)
+    {
+        take(datagram);
+        datagrams_.push_back(datagram);
+        addBitLength(datagram->getBitLength());
+    }
+
+    /// removes the first datagram from the message and returns it
+    cPacket* popDatagram()
+    {
+        cPacket* datagram = datagrams_.front();
+        datagrams_.pop_front();
+        drop(datagram);
+        addBitLength(-datagram->getBitLength());
+        return datagram;
+    }
+
+    bool hasDatagrams() const { return !datagrams_.empty(); }
+
+    unsigned int getNumDatagrams() const { return datagrams_.size(); }
 };
 
 //Register_Class(X2HandoverDataMsg);
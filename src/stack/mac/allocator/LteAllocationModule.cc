@@ -216,6 +216,21 @@ unsigned int LteAllocationModule::getAllocatedBlocks(Plane plane, const Remote a
     return allocatedRbsPerBand_[plane][antenna][band].allocated_;
 }
 
+void LteAllocationModule::getOccupiedBands(BandBitmap& occupiedBands)
+{
+    occupiedBands.assign(bands_, false);
+    if (allocatedRbsPerBand_.empty())
+        return;
+
+    const AllocatedRbsPerBandMap& bandMap = allocatedRbsPerBand_[MAIN_PLANE][MACRO];
+    AllocatedRbsPerBandMap::const_iterator it = bandMap.begin();
+    for (; it != bandMap.end(); ++it)
+    {
+        if (it->second.allocated_ > 0 && it->first < bands_)
+            occupiedBands[it->first] = true;
+    }
+}
+
 unsigned int LteAllocationModule::getInterferringBlocks(Plane plane, const Remote antenna, const Band band)
 {
     if (!prevAllocatedRbsPerBand_.empty())
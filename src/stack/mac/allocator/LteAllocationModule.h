@@ -293,18 +293,13 @@ class LteAllocationModule
      */
 
     // Store the Allocation based on passed parameters
-    virtual void storeAllocation( std::vector<std::vector<AllocatedRbsPerBandMapA> > allocatedRbsPerBand,std::set<Band>* untouchableBands = NULL)
+    virtual void storeAllocation(const std::vector<std::vector<AllocatedRbsPerBandMapA> >& allocatedRbsPerBand, const BandBitmap* untouchableBands = NULL)
     {
         return;
     }
 
-    // Get the bands already allocated
-    virtual std::set<Band> getAllocatorOccupiedBands()
-    {
-        std::set<Band> bandVector;
-        bandVector.clear();
-        return bandVector;
-    }
+    // Get the bands already allocated (MAIN plane, MACRO antenna)
+    void getOccupiedBands(BandBitmap& occupiedBands);
 
     // returns the number of logical bands
     unsigned int getNumBands()
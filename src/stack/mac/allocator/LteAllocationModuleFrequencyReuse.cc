@@ -16,29 +16,38 @@ LteAllocationModuleFrequencyReuse::LteAllocationModuleFrequencyReuse(LteMacEnb*
 {
 }
 
-void LteAllocationModuleFrequencyReuse::storeAllocation( std::vector<std::vector<AllocatedRbsPerBandMapA> > allocatedRbsPerBand,std::set<Band>* untouchableBands)
+// true if the band is marked as untouchable (a NULL bitmap marks no band)
+static bool isUntouchable(const BandBitmap* untouchableBands, Band band)
+{
+    return untouchableBands != NULL && band < untouchableBands->size() && (*untouchableBands)[band];
+}
+
+void LteAllocationModuleFrequencyReuse::storeAllocation(const std::vector<std::vector<AllocatedRbsPerBandMapA> >& allocatedRbsPerBand, const BandBitmap* untouchableBands)
 {
     Plane plane = MAIN_PLANE;
     const Remote antenna = MACRO;
     std::map<std::pair<MacNodeId,Band>,std::pair<unsigned int,unsigned int> > NodeIdRbsBytesMap;
     NodeIdRbsBytesMap.clear();
-    // Create an empty vector
-    if(untouchableBands==NULL)
-    {
-        std::set<Band> tempBand;
-        untouchableBands = &tempBand;
-        untouchableBands->clear();
-    }
 
+    const AllocatedRbsPerBandMapA& extBandMap = allocatedRbsPerBand[plane][antenna];
     for(unsigned int band=0;band<bands_;band++)
     {
         // Skip allocation if the band is untouchable (this means that the informations are already allocated)
-        if( untouchableBands->find(band) == untouchableBands->end() )
+        if( !isUntouchable(untouchableBands, band) )
         {
+            // bands without an entry carry no allocation
+            AllocatedRbsPerBandMapA::const_iterator it_band = extBandMap.find(band);
+            if (it_band == extBandMap.end())
+            {
+                allocatedRbsPerBand_[plane][antenna][band].allocated_ = 0;
+                continue;
+            }
+            const AllocatedRbsPerBandInfo& extInfo = it_band->second;
+
             // Copy the ueAllocatedRbsMap
-            UeAllocatedBlocksMapA::iterator it_ext = allocatedRbsPerBand[plane][antenna][band].ueAllocatedRbsMap_.begin();
-            UeAllocatedBlocksMapA::iterator et_ext = allocatedRbsPerBand[plane][antenna][band].ueAllocatedRbsMap_.end();
-            UeAllocatedBytesMapA::iterator it2_ext = allocatedRbsPerBand[plane][antenna][band].ueAllocatedBytesMap_.begin();
+            UeAllocatedBlocksMapA::const_iterator it_ext = extInfo.ueAllocatedRbsMap_.begin();
+            UeAllocatedBlocksMapA::const_iterator et_ext = extInfo.ueAllocatedRbsMap_.end();
+            UeAllocatedBytesMapA::const_iterator it2_ext = extInfo.ueAllocatedBytesMap_.begin();
 
             while(it_ext!=et_ext)
             {
@@ -55,9 +64,9 @@ void LteAllocationModuleFrequencyReuse::storeAllocation( std::vector<std::vector
                 it2_ext++;
             }
             // Copy the allocatedRbsPerBand
-            allocatedRbsPerBand_[plane][antenna][band].allocated_ = allocatedRbsPerBand[plane][antenna][band].allocated_;
+            allocatedRbsPerBand_[plane][antenna][band].allocated_ = extInfo.allocated_;
 
-            if (allocatedRbsPerBand[plane][antenna][band].allocated_ > 0)
+            if (extInfo.allocated_ > 0)
                 allocatedRbsMatrix_[MAIN_PLANE][MACRO] ++;
         }
     }
@@ -66,7 +75,7 @@ void LteAllocationModuleFrequencyReuse::storeAllocation( std::vector<std::vector
     while(it_rbsB!=NodeIdRbsBytesMap.end())
     {
         // Skip allocation if the band is untouchable (this means that the informations are already allocated)
-        if( untouchableBands->find(it_rbsB->first.second) == untouchableBands->end() )
+        if( !isUntouchable(untouchableBands, it_rbsB->first.second) )
         {
             allocatedRbsUe_[it_rbsB->first.first].ueAllocatedRbsMap_[antenna][it_rbsB->first.second] = it_rbsB->second.first; //Blocks
             allocatedRbsUe_[it_rbsB->first.first].allocatedBlocks_ += it_rbsB->second.first; //Blocks
@@ -83,39 +92,19 @@ void LteAllocationModuleFrequencyReuse::storeAllocation( std::vector<std::vector
     }
 }
 
-std::set<Band>  LteAllocationModuleFrequencyReuse::getAllocatorOccupiedBands()
-{
-    // TODO add support for logical band different from the number of real bands
-    std::set<Band> vectorBand;
-    vectorBand.clear();
-    for(unsigned int i=0;i<bands_;i++)
-    {
-        if( allocatedRbsPerBand_[MAIN_PLANE][MACRO][i].allocated_>0 ) vectorBand.insert(i);
-
-    }
-    return vectorBand;
-}
-
 /**
  * Check if the allocation respects the allocation constraints
  */
-void LteAllocationModuleFrequencyReuse::checkAllocation(std::set<Band>* untouchableBands)
+void LteAllocationModuleFrequencyReuse::checkAllocation(const BandBitmap* untouchableBands)
 {
     Plane plane = MAIN_PLANE;
     const Remote antenna = MACRO;
-    const std::map<MacNodeId,std::set<MacNodeId> >* conflictMap = mac_->getMeshMaster()->getConflictMap();
-    // Create an empty vector
-    if(untouchableBands==NULL)
-    {
-        std::set<Band> tempBand;
-        untouchableBands = &tempBand;
-        untouchableBands->clear();
-    }
+    const MeshMaster* meshMaster = mac_->getMeshMaster();
     // Fer every bands in the system
     for(unsigned int band=0;band<bands_;band++)
     {
         // Skip allocation if the band is untouchable (this means that the informations are already allocated)
-        if( untouchableBands->find(band) == untouchableBands->end() )
+        if( !isUntouchable(untouchableBands, band) )
         {
             // Copy the ueAllocatedRbsMap
             UeAllocatedBlocksMapA::iterator ref_it_ext = allocatedRbsPerBand_[plane][antenna][band].ueAllocatedRbsMap_.begin();
@@ -125,17 +114,12 @@ void LteAllocationModuleFrequencyReuse::checkAllocation(std::set<Band>* untoucha
                 // Set the iterator
                 UeAllocatedBlocksMapA::iterator it_ext = allocatedRbsPerBand_[plane][antenna][band].ueAllocatedRbsMap_.begin();
 
-                // If the node is present in the conflict map we have to check if there was an error in the allocation
-                if(conflictMap->find(ref_it_ext->first)!=conflictMap->end())
+                // For every nodeId in the band map
+                while(it_ext!=et_ext)
                 {
-                    // For every nodeId in the band map
-                    while(it_ext!=et_ext)
-                    {
-                        if(conflictMap->at(ref_it_ext->first).find(it_ext->first)!=conflictMap->at(ref_it_ext->first).end())
-                            throw cRuntimeError("checkAllocation(): error two conflicting nodes (%d and %d) are sharing the same band: %d",ref_it_ext->first,it_ext->first,band);
-                        ++it_ext;
-                    }
-
+                    if(meshMaster->isConflicting(ref_it_ext->first, it_ext->first))
+                        throw cRuntimeError("checkAllocation(): error two conflicting nodes (%d and %d) are sharing the same band: %d",ref_it_ext->first,it_ext->first,band);
+                    ++it_ext;
                 }
                 ++ref_it_ext;
             }
@@ -19,11 +19,9 @@ class LteAllocationModuleFrequencyReuse : public LteAllocationModule
     /// Default constructor.
     LteAllocationModuleFrequencyReuse(LteMacEnb *mac, const Direction direction);
     // Store the Allocation based on passed paremeter
-    virtual void storeAllocation( std::vector<std::vector<AllocatedRbsPerBandMapA> > allocatedRbsPerBand,std::set<Band>* untouchableBands = NULL);
-    // Get the bands already allocated by RAC and RTX ( Debug purpose)
-    virtual std::set<Band> getAllocatorOccupiedBands();
+    virtual void storeAllocation(const std::vector<std::vector<AllocatedRbsPerBandMapA> >& allocatedRbsPerBand, const BandBitmap* untouchableBands = NULL);
     // Check if the allocation respects the allocation constraints
-    virtual void checkAllocation(std::set<Band>* untouchableBands);
+    virtual void checkAllocation(const BandBitmap* untouchableBands);
 
 
 };
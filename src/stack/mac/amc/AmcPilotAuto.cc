@@ -29,7 +29,7 @@ const UserTxParams& AmcPilotAuto::computeTxParams(MacNodeId id, const Direction
      *  Note: this pilot is not DAS aware, so only MACRO antenna
      *  is used.
      */
-    LteSummaryFeedback sfb = amc_->getFeedback(id, MACRO, txMode, dir);
+    const LteSummaryFeedback& sfb = amc_->getFeedback(id, MACRO, txMode, dir);
 
     if (TxMode(txMode)==MULTI_USER) // Initialize MuMiMoMatrix
     amc_->muMimoMatrixInit(dir,id);
@@ -37,7 +37,7 @@ const UserTxParams& AmcPilotAuto::computeTxParams(MacNodeId id, const Direction
     sfb.print(0,id,dir,txMode,"AmcPilotAuto::computeTxParams");
 
     // get a vector of  CQI over first CW
-    std::vector<Cqi> summaryCqi = sfb.getCqi(0);
+    const std::vector<Cqi>& summaryCqi = sfb.getCqi(0);
 
     // get the usable bands for this user
     UsableBands* usableB = getUsableBands(id);
@@ -169,7 +169,7 @@ std::vector<Cqi> AmcPilotAuto::getMultiBandCqi(MacNodeId id , const Direction di
      *  Note: this pilot is not DAS aware, so only MACRO antenna
      *  is used.
      */
-    LteSummaryFeedback sfb = amc_->getFeedback(id, MACRO, txMode, dir);
+    const LteSummaryFeedback& sfb = amc_->getFeedback(id, MACRO, txMode, dir);
 
     // get a vector of  CQI over first CW
     return sfb.getCqi(0);
@@ -69,7 +69,7 @@ const UserTxParams& AmcPilotD2D::computeTxParams(MacNodeId id, const Direction d
 
     MacNodeId peerId = 0;  // FIXME this way, the getFeedbackD2D() function will return the first feedback available
 
-    LteSummaryFeedback sfb = (dir==UL || dir==DL) ? amc_->getFeedback(id, MACRO, txMode, dir) : amc_->getFeedbackD2D(id, MACRO, txMode, peerId);
+    const LteSummaryFeedback& sfb = (dir==UL || dir==DL) ? amc_->getFeedback(id, MACRO, txMode, dir) : amc_->getFeedbackD2D(id, MACRO, txMode, peerId);
 
     if (TxMode(txMode)==MULTI_USER) // Initialize MuMiMoMatrix
         amc_->muMimoMatrixInit(dir,id);
@@ -77,7 +77,7 @@ const UserTxParams& AmcPilotD2D::computeTxParams(MacNodeId id, const Direction d
     sfb.print(0,id,dir,txMode,"AmcPilotD2D::computeTxParams");
 
     // get a vector of  CQI over first CW
-    std::vector<Cqi> summaryCqi = sfb.getCqi(0);
+    const std::vector<Cqi>& summaryCqi = sfb.getCqi(0);
 
     Cqi chosenCqi;
     BandSet b;
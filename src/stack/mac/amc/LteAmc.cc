@@ -202,6 +202,7 @@ LteAmc::LteAmc(LteMacEnb *mac, LteBinder *binder, LteDeployer *deployer, int num
     binder_ = binder;
     deployer_ = deployer;
     numAntennas_ = numAntennas;
+    trackUpdatedUes_ = false;
     initialize();
 }
 
@@ -368,7 +369,7 @@ void LteAmc::rescaleMcs(double rePerRb, Direction dir)
  *    Functions for feedback management    *
  *******************************************/
 
-void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
+void LteAmc::pushFeedback(MacNodeId id, Direction dir, const LteFeedback& fb)
 {
     EV << "Feedback from MacNodeId " << id << " (direction " << dirToA(dir) << ")" << endl;
 
@@ -402,6 +403,8 @@ void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
     EV << "ID: " << id << endl;
     EV << "index: " << index << endl;
     (*history)[antenna].at(index).at(txMode).put(fb);
+    if (dir == UL && trackUpdatedUes_)
+        updatedUes_.insert(id);
 
     // DEBUG
 //    printFbhb(dir);
@@ -412,7 +415,7 @@ void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
 //    (*history)[antenna].at(index).at(txMode).get().print(0,id,dir,txMode,"LteAmc::pushFeedback");
 }
 
-void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
+void LteAmc::pushFeedbackD2D(MacNodeId id, const LteFeedback& fb, MacNodeId peerId)
 {
     EV << "Feedback from MacNodeId " << id << " (direction D2D), peerId = " << peerId << endl;
 
@@ -442,6 +445,12 @@ void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
         (*history)[peerId] = newHist;
     }
     (*history)[peerId][antenna].at(index).at(txMode).put(fb);
+    // the report affects the D2D link between the two peers
+    if (trackUpdatedUes_)
+    {
+        updatedUes_.insert(id);
+        updatedUes_.insert(peerId);
+    }
 
     // DEBUG
     EV << "PeerId: " << peerId << ", Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
@@ -450,7 +459,7 @@ void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
 }
 
 
-LteSummaryFeedback LteAmc::getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir)
+const LteSummaryFeedback& LteAmc::getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir)
 {
     MacNodeId nh = getNextHop(id);
     if (id != nh)
@@ -467,7 +476,7 @@ LteSummaryFeedback LteAmc::getFeedback(MacNodeId id, Remote antenna, TxMode txMo
     }
 }
 
-LteSummaryFeedback LteAmc::getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId)
+const LteSummaryFeedback& LteAmc::getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId)
 {
     MacNodeId nh = getNextHop(id);
 
@@ -88,6 +88,10 @@ class LteAmc
     LteMuMimoMatrix muMimoDlMatrix_;
     LteMuMimoMatrix muMimoUlMatrix_;
     LteMuMimoMatrix muMimoD2DMatrix_;
+    // UEs whose UL or D2D feedback changed since the last call to takeUpdatedUes()
+    std::set<MacNodeId> updatedUes_;
+    // true once takeUpdatedUes() has been called, i.e. there is a D2D mode selection consuming updatedUes_
+    bool trackUpdatedUes_;
     public:
     LteAmc(LteMacEnb *mac, LteBinder *binder, LteDeployer *deployer, int numAntennas);
     void initialize();
@@ -104,10 +108,18 @@ class LteAmc
     // CodeRate MCS rescaling
     void rescaleMcs(double rePerRb, Direction dir = DL);
 
-    void pushFeedback(MacNodeId id, Direction dir, LteFeedback fb);
-    void pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId);
-    LteSummaryFeedback getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir);
-    LteSummaryFeedback getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId);
+    void pushFeedback(MacNodeId id, Direction dir, const LteFeedback& fb);
+    void pushFeedbackD2D(MacNodeId id, const LteFeedback& fb, MacNodeId peerId);
+    const LteSummaryFeedback& getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir);
+    const LteSummaryFeedback& getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId);
+
+    // adds to ues the UEs whose UL or D2D feedback changed since the last call (used by D2D mode selection)
+    void takeUpdatedUes(std::set<MacNodeId>& ues)
+    {
+        trackUpdatedUes_ = true;
+        ues.insert(updatedUes_.begin(), updatedUes_.end());
+        updatedUes_.clear();
+    }
 
     //used when is necessary to know if the requested feedback exists or not
     // LteSummaryFeedback getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir,bool& valid);
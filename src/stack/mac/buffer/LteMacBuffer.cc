@@ -14,7 +14,8 @@ LteMacBuffer::LteMacBuffer()
     queueOccupancy_ = 0;
     queueLength_ = 0;
     processed_ = 0;
-    Queue_.clear();
+    head_ = 0;
+    Queue_.resize(MAC_BUFFER_INITIAL_SLOTS);
 }
 
 LteMacBuffer::LteMacBuffer(const LteMacQueue& queue)
@@ -32,6 +33,7 @@ LteMacBuffer& LteMacBuffer::operator=(const LteMacBuffer& queue)
     queueOccupancy_ = queue.queueOccupancy_;
     queueLength_ = queue.queueLength_;
     Queue_ = queue.Queue_;
+    head_ = queue.head_;
     return *this;
 }
 
@@ -40,18 +42,35 @@ LteMacBuffer* LteMacBuffer::dup() const
     return new LteMacBuffer(*this);
 }
 
+void LteMacBuffer::grow()
+{
+    unsigned int slots = Queue_.size();
+    std::vector<PacketInfo> ring(2 * slots);
+    for (int i = 0; i < queueLength_; i++)
+        ring[i] = Queue_[(head_ + i) & (slots - 1)];
+    Queue_.swap(ring);
+    head_ = 0;
+}
+
 void LteMacBuffer::pushBack(PacketInfo pkt)
 {
+    if ((unsigned int)queueLength_ == Queue_.size())
+        grow();
+
+    Queue_[(head_ + queueLength_) & (Queue_.size() - 1)] = pkt;
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_back(pkt);
 }
 
 void LteMacBuffer::pushFront(PacketInfo pkt)
 {
+    if ((unsigned int)queueLength_ == Queue_.size())
+        grow();
+
+    head_ = (head_ - 1) & (Queue_.size() - 1);
+    Queue_[head_] = pkt;
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_front(pkt);
 }
 
 PacketInfo LteMacBuffer::popFront()
@@ -59,8 +78,8 @@ PacketInfo LteMacBuffer::popFront()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.front();
-    Queue_.pop_front();
+    PacketInfo pkt = Queue_[head_];
+    head_ = (head_ + 1) & (Queue_.size() - 1);
     processed_++;
     queueLength_--;
     queueOccupancy_ -= pkt.first;
@@ -72,9 +91,8 @@ PacketInfo LteMacBuffer::popBack()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.back();
-    Queue_.pop_back();
     queueLength_--;
+    PacketInfo pkt = Queue_[(head_ + queueLength_) & (Queue_.size() - 1)];
     queueOccupancy_ -= pkt.first;
     return pkt;
 }
@@ -83,14 +101,32 @@ PacketInfo& LteMacBuffer::front()
 {
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
-    return Queue_.front();
+    return Queue_[head_];
 }
 
 PacketInfo LteMacBuffer::back() const
 {
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
-    return Queue_.back();
+    return Queue_[(head_ + queueLength_ - 1) & (Queue_.size() - 1)];
+}
+
+void LteMacBuffer::shrinkFront(unsigned int bytes)
+{
+    if (queueLength_ <= 0)
+        throw cRuntimeError("Packet queue empty");
+
+    PacketInfo& pkt = Queue_[head_];
+    if (bytes >= (unsigned int)pkt.first)
+    {
+        // the whole packet has been consumed
+        popFront();
+        return;
+    }
+    pkt.first -= bytes;
+    queueOccupancy_ -= bytes;
+    // counted as the pop and push of the front packet
+    processed_++;
 }
 
 void LteMacBuffer::setProcessed(unsigned int i)
@@ -102,7 +138,7 @@ simtime_t LteMacBuffer::getHolTimestamp() const
 {
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
-    return Queue_.front().second;
+    return Queue_[head_].second;
 }
 
 unsigned int LteMacBuffer::getProcessed() const
@@ -110,10 +146,11 @@ unsigned int LteMacBuffer::getProcessed() const
     return processed_;
 }
 
-const std::list<PacketInfo>*
-LteMacBuffer::getPacketlist() const
+const PacketInfo& LteMacBuffer::at(unsigned int i) const
 {
-    return &Queue_;
+    if (i >= (unsigned int)queueLength_)
+        throw cRuntimeError("LteMacBuffer::at - index %u out of range", i);
+    return Queue_[(head_ + i) & (Queue_.size() - 1)];
 }
 
 unsigned int LteMacBuffer::getQueueOccupancy() const
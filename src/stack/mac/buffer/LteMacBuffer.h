@@ -15,9 +15,17 @@
 
 class LteMacQueue;
 
+/// Initial number of slots of the packet-info ring (must be a power of two)
+#define MAC_BUFFER_INITIAL_SLOTS 16
+
 /**
  * @class LteMacBuffer
  * @brief  Buffers for MAC packets
+ *
+ * The (size, arrival time) pairs are stored in a contiguous ring
+ * that doubles its capacity when full and never shrinks, so that
+ * a steady-state buffer does not allocate memory. The byte occupancy
+ * is kept as a running total, thus all queries are O(1).
  */
 class LteMacBuffer
 {
@@ -90,6 +98,17 @@ class LteMacBuffer
      */
     PacketInfo back() const;
 
+    /**
+     * shrinkFront() reduces the size of the packet in front
+     * of the queue, removing it if its size drops to zero.
+     * The queue occupancy is updated accordingly.
+     * NOTE: This function increases the processed_ variable, like
+     * popping the packet and pushing it back with the reduced size.
+     *
+     * @param bytes number of bytes to remove from the front packet
+     */
+    void shrinkFront(unsigned int bytes);
+
     /**
      * setProcessed() sets the value of the
      * processed_ variable
@@ -139,13 +158,20 @@ class LteMacBuffer
     unsigned int getProcessed() const;
 
     /**
-     * Get direct (readonly) access to pdu list
+     * Get direct (readonly) access to the i-th packet
+     * of the queue, starting from the front
      */
-    const std::list<PacketInfo>* getPacketlist() const;
+    const PacketInfo& at(unsigned int i) const;
 
     friend std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue);
 
   private:
+    /**
+     * grow() doubles the capacity of the ring, moving
+     * the queued packets at the beginning of the storage
+     */
+    void grow();
+
     /// Number of packets processed by the scheduler
     unsigned int processed_;
 
@@ -155,8 +181,11 @@ class LteMacBuffer
     /// Number of queued  packets
     int queueLength_;
 
-    /// List of  packets
-    std::list<PacketInfo> Queue_;
+    /// Ring of  packets (capacity is a power of two)
+    std::vector<PacketInfo> Queue_;
+
+    /// Index of the front packet in the ring
+    unsigned int head_;
 };
 
 #endif
@@ -31,6 +31,7 @@ LteHarqBufferRx::LteHarqBufferRx(unsigned int num, LteMacBase *owner,
     {
         processes_[i] = new LteHarqProcessRx(i, macOwner_);
     }
+    initStatusMask();
 
     /* Signals initialization: those are used to gather statistics */
     if (macOwner_->getNodeType() == ENODEB)
@@ -63,15 +64,27 @@ void LteHarqBufferRx::insertPdu(Codeword cw, LteMacPdu *pdu)
     unsigned char acid = uInfo->getAcid();
     // TODO add codeword to inserPdu
     processes_[acid]->insertPdu(cw, pdu);
+    // the MAC will look for correct pdus in this buffer
+    macOwner_->harqRxPending_.insert(nodeId_);
     // debug output
     EV << "H-ARQ RX: new pdu (id " << pdu->getId()
        << " ) inserted into process " << (int) acid << endl;
 }
 
-void LteHarqBufferRx::sendFeedback()
+void LteHarqBufferRx::initStatusMask()
 {
+    statusMask_ = LteHarqStatusMask(numHarqProcesses_, RXHARQ_PDU_CORRUPTED + 1, RXHARQ_PDU_EMPTY);
     for (unsigned int i = 0; i < numHarqProcesses_; i++)
+        processes_[i]->setStatusMask(&statusMask_);
+}
+
+void LteHarqBufferRx::sendFeedback()
+{
+    // only processes with a pdu under evaluation can send feedback
+    uint64_t evaluating = statusMask_.getAny(RXHARQ_PDU_EVALUATING);
+    for (; evaluating != 0; evaluating &= evaluating - 1)
     {
+        unsigned int i = lowestSetBit(evaluating);
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
         {
             if (processes_[i]->isEvaluated(cw))
@@ -98,8 +111,10 @@ unsigned int LteHarqBufferRx::purgeCorruptedPdus()
 {
     unsigned int purged = 0;
 
-    for (unsigned int i = 0; i < numHarqProcesses_; i++)
+    uint64_t corrupted = statusMask_.getAny(RXHARQ_PDU_CORRUPTED);
+    for (; corrupted != 0; corrupted &= corrupted - 1)
     {
+        unsigned int i = lowestSetBit(corrupted);
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
         {
             if (processes_[i]->getUnitStatus(cw) == RXHARQ_PDU_CORRUPTED)
@@ -117,12 +132,24 @@ unsigned int LteHarqBufferRx::purgeCorruptedPdus()
 }
 
 std::list<LteMacPdu *> LteHarqBufferRx::extractCorrectPdus()
+{
+    std::vector<LteMacPdu*> pdus;
+    extractCorrectPdus(pdus);
+    return std::list<LteMacPdu*>(pdus.begin(), pdus.end());
+}
+
+void LteHarqBufferRx::extractCorrectPdus(std::vector<LteMacPdu*>& ret)
 {
     this->sendFeedback();
-    std::list<LteMacPdu*> ret;
+    // NACKed pdus are purged later by the MAC
+    if (statusMask_.getAny(RXHARQ_PDU_CORRUPTED) != 0)
+        macOwner_->harqRxCorrupted_.insert(nodeId_);
+
     unsigned char acid = 0;
-    for (unsigned int i = 0; i < numHarqProcesses_; i++)
+    uint64_t correct = statusMask_.getAny(RXHARQ_PDU_CORRECT);
+    for (; correct != 0; correct &= correct - 1)
     {
+        unsigned int i = lowestSetBit(correct);
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
         {
             if (processes_[i]->isCorrect(cw))
@@ -161,8 +188,6 @@ std::list<LteMacPdu *> LteHarqBufferRx::extractCorrectPdus()
             }
         }
     }
-
-    return ret;
 }
 
 RxBufferStatus LteHarqBufferRx::getBufferStatus()
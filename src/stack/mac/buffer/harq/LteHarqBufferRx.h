@@ -45,6 +45,9 @@ class LteHarqBufferRx
     /// flag for multicast flows
     bool isMulticast_;
 
+    /// status of all codewords, indexed by RxHarqPduStatus and codeword
+    LteHarqStatusMask statusMask_;
+
     //Statistics
     static unsigned int totalCellRcvdBytes_;
     unsigned int totalRcvdBytes_ = 0;
@@ -73,7 +76,24 @@ class LteHarqBufferRx
      *
      * @return uncorrupted pdus or empty list if none
      */
-    virtual std::list<LteMacPdu*> extractCorrectPdus();
+    std::list<LteMacPdu*> extractCorrectPdus();
+
+    /**
+     * Sends feedback for all processes which are older than
+     * HARQ_FB_EVALUATION_INTERVAL, then extract the pdu in correct state (if any)
+     *
+     * @param pdus vector where uncorrupted pdus are appended
+     */
+    virtual void extractCorrectPdus(std::vector<LteMacPdu*>& pdus);
+
+    /**
+     * @return true if some pdu is under evaluation or ready to be extracted,
+     * i.e. extractCorrectPdus() has still something to do
+     */
+    bool hasPendingPdus() const
+    {
+        return (statusMask_.getAny(RXHARQ_PDU_EVALUATING) | statusMask_.getAny(RXHARQ_PDU_CORRECT)) != 0;
+    }
 
     /**
      * Purges PDUs in corrupted state (if any)
@@ -99,6 +119,12 @@ class LteHarqBufferRx
     // @return whole buffer status {RXHARQ_PDU_EMPTY, RXHARQ_PDU_EVALUATING, RXHARQ_PDU_CORRECT, RXHARQ_PDU_CORRUPTED }
     RxBufferStatus getBufferStatus();
 
+    // @return per-status bitmasks of the codewords of all processes
+    const LteHarqStatusMask& getStatusMask() const
+    {
+        return statusMask_;
+    }
+
     /**
      * Returns a pair with h-arq process id and a list of its empty {RXHARQ_PDU_EMPTY} units to be used for reception of new H-arq sub-bursts.
      *
@@ -119,6 +145,12 @@ class LteHarqBufferRx
      * feedback if affirmative.
      */
     virtual void sendFeedback();
+
+    /**
+     * Creates the status masks and attaches them to the processes.
+     * Must be called by constructors, after the processes have been created.
+     */
+    void initStatusMask();
 };
 
 #endif
@@ -15,12 +15,13 @@ LteHarqBufferTx::LteHarqBufferTx(unsigned int numProc, LteMacBase *owner, LteMac
     macOwner_ = owner;
     nodeId_ = dstMac->getMacNodeId();
     selectedAcid_ = HARQ_NONE;
-    processes_ = new std::vector<LteHarqProcessTx *>(numProc);
+    processes_.resize(numProc);
     numEmptyProc_ = numProc;
     for (unsigned int i = 0; i < numProc_; i++)
     {
-        (*processes_)[i] = new LteHarqProcessTx(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
+        processes_[i] = new LteHarqProcessTx(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
     }
+    statusMask_ = LteHarqStatusMask(numProc_, TXHARQ_PDU_SELECTED + 1, TXHARQ_PDU_EMPTY);
 }
 
 UnitList LteHarqBufferTx::firstReadyForRtx()
@@ -29,30 +30,30 @@ UnitList LteHarqBufferTx::firstReadyForRtx()
     simtime_t oldestTxTime = NOW + 1;
     simtime_t currentTxTime = 0;
 
-    for (unsigned int i = 0; i < numProc_; i++)
+    // visit only the processes having at least one unit ready for rtx
+    uint64_t ready = statusMask_.getAny(TXHARQ_PDU_BUFFERED);
+    for (; ready != 0; ready &= ready - 1)
     {
-        if ((*processes_)[i]->hasReadyUnits())
+        unsigned char i = lowestSetBit(ready);
+        currentTxTime = processes_[i]->getOldestUnitTxTime();
+        if (currentTxTime < oldestTxTime)
         {
-            currentTxTime = (*processes_)[i]->getOldestUnitTxTime();
-            if (currentTxTime < oldestTxTime)
-            {
-                oldestTxTime = currentTxTime;
-                oldestProcessAcid = i;
-            }
+            oldestTxTime = currentTxTime;
+            oldestProcessAcid = i;
         }
     }
     UnitList ret;
     ret.first = oldestProcessAcid;
     if (oldestProcessAcid != HARQ_NONE)
     {
-        ret.second = (*processes_)[oldestProcessAcid]->readyUnitsIds();
+        ret.second = processes_[oldestProcessAcid]->readyUnitsIds();
     }
     return ret;
 }
 
 inet::int64 LteHarqBufferTx::pduLength(unsigned char acid, Codeword cw)
 {
-    return (*processes_)[acid]->getPduLength(cw);
+    return processes_[acid]->getPduLength(cw);
 }
 
 void LteHarqBufferTx::markSelected(UnitList unitIds, unsigned char availableTbs)
@@ -78,19 +79,19 @@ void LteHarqBufferTx::markSelected(UnitList unitIds, unsigned char availableTbs)
         // this is the codeword which will contain the jumbo TB
         Codeword cw = cwList.front();
         cwList.pop_front();
-        LteMacPdu *basePdu = (*processes_)[acid]->getPdu(cw);
+        LteMacPdu *basePdu = processes_[acid]->getPdu(cw);
         while (cwList.size() > 0)
         {
             Codeword cw = cwList.front();
             cwList.pop_front();
-            LteMacPdu *guestPdu = (*processes_)[acid]->getPdu(cw);
+            LteMacPdu *guestPdu = processes_[acid]->getPdu(cw);
             while(guestPdu->hasSdu())
             basePdu->pushSdu(guestPdu->popSdu());
             while(guestPdu->hasCe())
             basePdu->pushCe(guestPdu->popCe());
-            (*processes_)[acid]->dropPdu(cw);
+            processes_[acid]->dropPdu(cw);
         }
-        (*processes_)[acid]->markSelected(cw);
+        processes_[acid]->markSelected(cw);
     }
     else
     {
@@ -98,11 +99,12 @@ void LteHarqBufferTx::markSelected(UnitList unitIds, unsigned char availableTbs)
         // all units are marked
         for (it = cwList.begin(); it != cwList.end(); it++)
         {
-            (*processes_)[acid]->markSelected(*it);
+            processes_[acid]->markSelected(*it);
         }
     }
 
     selectedAcid_ = acid;
+    updateStatusMask(acid);
 
     // user tx params could have changed, modify them
     //    UserControlInfo *uInfo = check_and_cast<UserControlInfo *>(basePdu->getControlInfo());
@@ -118,16 +120,17 @@ void LteHarqBufferTx::insertPdu(unsigned char acid, Codeword cw, LteMacPdu *pdu)
     if (selectedAcid_ == HARQ_NONE)
     {
         // the process has not been used for rtx, or it is the first TB inserted, it must be completely empty
-        if (!(*processes_)[acid]->isEmpty())
+        if (!processes_[acid]->isEmpty())
             throw cRuntimeError("H-ARQ TX buffer: new process selected for tx is not completely empty");
     }
 
-    if (!(*processes_)[acid]->isUnitEmpty(cw))
+    if (!processes_[acid]->isUnitEmpty(cw))
         throw cRuntimeError("LteHarqBufferTx::insertPdu(): unit is not empty");
 
     selectedAcid_ = acid;
     numEmptyProc_--;
-    (*processes_)[acid]->insertPdu(pdu, cw);
+    processes_[acid]->insertPdu(pdu, cw);
+    updateStatusMask(acid);
 
     // debug output
     EV << "H-ARQ TX: new pdu (id " << pdu->getId() << " ) inserted into process " << (int)acid << " "
@@ -144,14 +147,8 @@ LteHarqBufferTx::firstAvailable()
 
     if (selectedAcid_ == HARQ_NONE)
     {
-        for (unsigned int i = 0; i < numProc_; i++)
-        {
-            if ((*processes_)[i]->isEmpty())
-            {
-                acid = i;
-                break;
-            }
-        }
+        // first process whose units are all empty
+        acid = LteHarqStatusMask::first(statusMask_.getAll(TXHARQ_PDU_EMPTY));
     }
     else
     {
@@ -162,7 +159,7 @@ LteHarqBufferTx::firstAvailable()
     if (acid != HARQ_NONE)
     {
         // if there is any free process, return empty list
-        ret.second = (*processes_)[acid]->emptyUnitsIds();
+        ret.second = processes_[acid]->emptyUnitsIds();
     }
 
     return ret;
@@ -173,7 +170,7 @@ UnitList LteHarqBufferTx::getEmptyUnits(unsigned char acid)
     // TODO add multi CW check and retx checks
     UnitList ret;
     ret.first = acid;
-    ret.second = (*processes_)[acid]->emptyUnitsIds();
+    ret.second = processes_[acid]->emptyUnitsIds();
     return ret;
 }
 
@@ -186,10 +183,10 @@ void LteHarqBufferTx::receiveHarqFeedback(LteHarqFeedback *fbpkt)
     Codeword cw = fbpkt->getCw();
     unsigned char acid = fbpkt->getAcid();
     long fbPduId = fbpkt->getFbMacPduId(); // id of the pdu that should receive this fb
-    long unitPduId = (*processes_)[acid]->getPduId(cw);
+    long unitPduId = processes_[acid]->getPduId(cw);
 
     // After handover or a D2D mode switch, the process nay have been dropped. The received feedback must be ignored.
-    if ((*processes_)[acid]->isDropped())
+    if (processes_[acid]->isDropped())
     {
         EV << "H-ARQ TX buffer: received pdu for acid " << (int)acid << ". The corresponding unit has been "
         " reset after handover or a D2D mode switch (the contained pdu was dropped). Ignore feedback." << endl;
@@ -207,9 +204,10 @@ void LteHarqBufferTx::receiveHarqFeedback(LteHarqFeedback *fbpkt)
         // todo: comment endsim after tests
         throw cRuntimeError("H-ARQ TX: fb is not for the pdu in this unit, maybe the addressed one was dropped");
     }
-    bool reset = (*processes_)[acid]->pduFeedback(harqResult, cw);
+    bool reset = processes_[acid]->pduFeedback(harqResult, cw);
     if (reset)
     numEmptyProc_++;
+    updateStatusMask(acid);
 
     // debug output
     const char *ack = result ? "ACK" : "NACK";
@@ -228,11 +226,11 @@ void LteHarqBufferTx::sendSelectedDown()
         return;
     }
 
-    CwList ul = (*processes_)[selectedAcid_]->selectedUnitsIds();
+    CwList ul = processes_[selectedAcid_]->selectedUnitsIds();
     CwList::iterator it;
     for (it = ul.begin(); it != ul.end(); it++)
     {
-        LteMacPdu *pduToSend = (*processes_)[selectedAcid_]->extractPdu(*it);
+        LteMacPdu *pduToSend = processes_[selectedAcid_]->extractPdu(*it);
         macOwner_->sendLowerPackets(pduToSend);
 
         // debug output
@@ -240,55 +238,60 @@ void LteHarqBufferTx::sendSelectedDown()
         "codeword " << (int)*it << " for node with id " <<
         check_and_cast<UserControlInfo *>(pduToSend->getControlInfo())->getDestId() << endl;
     }
+    updateStatusMask(selectedAcid_);
     selectedAcid_ = HARQ_NONE;
 }
 
 void LteHarqBufferTx::dropProcess(unsigned char acid)
 {
     // pdus can be dropped only if the unit is in BUFFERED state.
-    CwList ul = (*processes_)[acid]->readyUnitsIds();
+    CwList ul = processes_[acid]->readyUnitsIds();
     CwList::iterator it;
 
     for (it = ul.begin(); it != ul.end(); it++)
     {
-        (*processes_)[acid]->dropPdu(*it);
+        processes_[acid]->dropPdu(*it);
     }
     // if a process contains units in BUFFERED state, then all units of this
     // process are either empty or in BUFFERED state (ready).
     numEmptyProc_++;
+    updateStatusMask(acid);
 }
 
 void LteHarqBufferTx::selfNack(unsigned char acid, Codeword cw)
 {
     bool reset = false;
-    CwList ul = (*processes_)[acid]->readyUnitsIds();
+    CwList ul = processes_[acid]->readyUnitsIds();
     CwList::iterator it;
 
     for (it = ul.begin(); it != ul.end(); it++)
     {
-        reset = (*processes_)[acid]->selfNack(*it);
+        reset = processes_[acid]->selfNack(*it);
     }
     if (reset)
         numEmptyProc_++;
+    updateStatusMask(acid);
 }
 
 void LteHarqBufferTx::forceDropProcess(unsigned char acid)
 {
-    (*processes_)[acid]->forceDropProcess();
+    processes_[acid]->forceDropProcess();
     if (acid == selectedAcid_)
         selectedAcid_ = HARQ_NONE;
     numEmptyProc_++;
+    updateStatusMask(acid);
 }
 
 void LteHarqBufferTx::forceDropUnit(unsigned char acid, Codeword cw)
 {
-    bool reset = (*processes_)[acid]->forceDropUnit(cw);
+    bool reset = processes_[acid]->forceDropUnit(cw);
     if (reset)
     {
         if (acid == selectedAcid_)
             selectedAcid_ = HARQ_NONE;
         numEmptyProc_++;
     }
+    updateStatusMask(acid);
 }
 
 BufferStatus LteHarqBufferTx::getBufferStatus()
@@ -297,9 +300,9 @@ BufferStatus LteHarqBufferTx::getBufferStatus()
     unsigned int numHarqUnits = 0;
     for (unsigned int i = 0; i < numProc_; i++)
     {
-        numHarqUnits = (*processes_)[i]->getNumHarqUnits();
+        numHarqUnits = processes_[i]->getNumHarqUnits();
         std::vector<UnitStatus> vus(numHarqUnits);
-        vus = (*processes_)[i]->getProcessStatus();
+        vus = processes_[i]->getProcessStatus();
         bs[i] = vus;
     }
     return bs;
@@ -310,7 +313,7 @@ LteHarqBufferTx::getProcess(unsigned char acid)
 {
     try
     {
-        return (*processes_).at(acid);
+        return processes_.at(acid);
     }
     catch (std::out_of_range & x)
     {
@@ -326,13 +329,11 @@ LteHarqBufferTx::getSelectedProcess()
 
 LteHarqBufferTx::~LteHarqBufferTx()
 {
-    std::vector<LteHarqProcessTx *>::iterator it = processes_->begin();
-    for (; it != processes_->end(); ++it)
+    std::vector<LteHarqProcessTx *>::iterator it = processes_.begin();
+    for (; it != processes_.end(); ++it)
         delete *it;
 
-    processes_->clear();
-    delete processes_;
-    processes_ = NULL;
+    processes_.clear();
     macOwner_ = NULL;
 }
 
@@ -351,3 +352,11 @@ bool LteHarqBufferTx::isInUnitList(unsigned char acid, Codeword cw, UnitList uni
     }
     return false;
 }
+
+void LteHarqBufferTx::updateStatusMask(unsigned char acid)
+{
+    LteHarqProcessTx* process = processes_[acid];
+    unsigned int numUnits = process->getNumHarqUnits();
+    for (Codeword cw = 0; cw < numUnits; ++cw)
+        statusMask_.set(acid, cw, process->getUnitStatus(cw));
+}
@@ -13,6 +13,7 @@
 #include <vector>
 #include "stack/mac/packet/LteHarqFeedback_m.h"
 #include "stack/mac/buffer/harq/LteHarqProcessTx.h"
+#include "stack/mac/buffer/harq/LteHarqStatusMask.h"
 
 /*
  * NOTA: e' compito del mac ul usare solo il processo di turno, non c'e' nessun controllo.
@@ -24,12 +25,15 @@ class LteHarqBufferTx
 {
   protected:
     LteMacBase *macOwner_;
-    std::vector<LteHarqProcessTx *> *processes_;
+    std::vector<LteHarqProcessTx *> processes_;
     unsigned int numProc_;
     unsigned int numEmptyProc_; // @ fb on reset, @ insert
     unsigned char selectedAcid_; // @ insert, @ marksel, @ sendseldn
     MacNodeId nodeId_; // UE nodeId for which this buffer has been created
 
+    /// status of all units, indexed by TxHarqPduStatus and codeword
+    LteHarqStatusMask statusMask_;
+
   public:
 
     /*
@@ -173,6 +177,16 @@ class LteHarqBufferTx
 
     BufferStatus getBufferStatus();
 
+    /*
+     * Returns the per-status bitmasks of the units of this buffer.
+     * Bit <acid> of get(TXHARQ_PDU_BUFFERED, cw) is set if the unit <acid, cw>
+     * is ready for retransmission.
+     */
+    const LteHarqStatusMask& getStatusMask() const
+    {
+        return statusMask_;
+    }
+
     virtual ~LteHarqBufferTx();
 
   protected:
@@ -185,6 +199,15 @@ class LteHarqBufferTx
      * @return true if the id is in the list, false otherwise.
      */
     bool isInUnitList(unsigned char acid, Codeword cw, UnitList unitIds);
+
+    /**
+     * Refreshes the status masks with the current status of the
+     * units of a process. It must be called whenever an operation
+     * may have changed the status of one of these units.
+     *
+     * @param acid the H-arq process
+     */
+    void updateStatusMask(unsigned char acid);
 };
 
 #endif
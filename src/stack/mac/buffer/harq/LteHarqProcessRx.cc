@@ -23,6 +23,7 @@ LteHarqProcessRx::LteHarqProcessRx(unsigned char acid, LteMacBase *owner)
     macOwner_ = owner;
     transmissions_ = 0;
     maxHarqRtx_ = owner->par("maxHarqRtx");
+    statusMask_ = NULL;
 }
 
 void LteHarqProcessRx::insertPdu(Codeword cw, LteMacPdu *pdu)
@@ -48,7 +49,7 @@ void LteHarqProcessRx::insertPdu(Codeword cw, LteMacPdu *pdu)
     // store new received pdu
     pdu_.at(cw) = pdu;
     result_.at(cw) = lteInfo->getDeciderResult();
-    status_.at(cw) = RXHARQ_PDU_EVALUATING;
+    setStatus(cw, RXHARQ_PDU_EVALUATING);
     rxTime_.at(cw) = NOW;
 
     transmissions_++;
@@ -83,7 +84,7 @@ LteHarqFeedback *LteHarqProcessRx::createFeedback(Codeword cw)
     if (!result_.at(cw))
     {
         // NACK will be sent
-        status_.at(cw) = RXHARQ_PDU_CORRUPTED;
+        setStatus(cw, RXHARQ_PDU_CORRUPTED);
 
         EV << "LteHarqProcessRx::createFeedback - tx number " << (unsigned int)transmissions_ << endl;
         if (transmissions_ == (maxHarqRtx_ + 1))
@@ -97,7 +98,7 @@ LteHarqFeedback *LteHarqProcessRx::createFeedback(Codeword cw)
     }
     else
     {
-        status_.at(cw) = RXHARQ_PDU_CORRECT;
+        setStatus(cw, RXHARQ_PDU_CORRECT);
     }
 
     return fb;
@@ -149,7 +150,7 @@ void LteHarqProcessRx::resetCodeword(Codeword cw)
     }
 
     pdu_.at(cw) = NULL;
-    status_.at(cw) = RXHARQ_PDU_EMPTY;
+    setStatus(cw, RXHARQ_PDU_EMPTY);
     rxTime_.at(cw) = 0;
     result_.at(cw) = false;
 
@@ -13,6 +13,7 @@
 #include <omnetpp.h>
 
 #include "common/LteCommon.h"
+#include "stack/mac/buffer/harq/LteHarqStatusMask.h"
 
 typedef std::pair<unsigned char, RxHarqPduStatus> RxUnitStatus;
 typedef std::vector<std::vector<RxUnitStatus> > RxBufferStatus;
@@ -58,6 +59,20 @@ class LteHarqProcessRx
 
     unsigned char maxHarqRtx_;
 
+    /// status masks of the owning buffer (NULL if not tracked)
+    LteHarqStatusMask* statusMask_;
+
+    /**
+     * Changes the status of a codeword, keeping the status masks
+     * of the owning buffer up to date.
+     */
+    void setStatus(Codeword cw, RxHarqPduStatus status)
+    {
+        status_.at(cw) = status;
+        if (statusMask_ != NULL)
+            statusMask_->set(acid_, cw, status);
+    }
+
   public:
 
     /**
@@ -144,6 +159,15 @@ class LteHarqProcessRx
         return MAX_CODEWORDS;
     }
 
+    /**
+     * Attaches the status masks of the owning buffer, which will be
+     * updated on every status change of this process' codewords.
+     */
+    void setStatusMask(LteHarqStatusMask* statusMask)
+    {
+        statusMask_ = statusMask;
+    }
+
     virtual ~LteHarqProcessRx();
 
   protected:
@@ -15,7 +15,7 @@ LteHarqProcessTx::LteHarqProcessTx(unsigned char acid, unsigned int numUnits, un
     macOwner_ = macOwner;
     acid_ = acid;
     numHarqUnits_ = numUnits;
-    units_ = new UnitVector(numUnits);
+    units_.resize(numUnits);
     numProcesses_ = numProcesses;
     numEmptyUnits_ = numUnits; //++ @ insert, -- @ unit reset (ack or fourth nack)
     numSelected_ = 0; //++ @ markSelected and insert, -- @ extract/sendDown
@@ -24,7 +24,7 @@ LteHarqProcessTx::LteHarqProcessTx(unsigned char acid, unsigned int numUnits, un
     // H-ARQ unit instances
     for (unsigned int i = 0; i < numHarqUnits_; i++)
     {
-        (*units_)[i] = new LteHarqUnitTx(acid, i, macOwner_, dstMac);
+        units_[i] = new LteHarqUnitTx(acid, i, macOwner_, dstMac);
     }
 }
 
@@ -45,7 +45,7 @@ void LteHarqProcessTx::insertPdu(LteMacPdu *pdu, Codeword cw)
 {
     numEmptyUnits_--;
     numSelected_++;
-    (*units_)[cw]->insertPdu(pdu);
+    units_[cw]->insertPdu(pdu);
     dropped_ = false;
 }
 
@@ -55,7 +55,7 @@ void LteHarqProcessTx::markSelected(Codeword cw)
         throw cRuntimeError("H-ARQ TX process: cannot select another unit because they are all already selected");
 
     numSelected_++;
-    (*units_)[cw]->markSelected();
+    units_[cw]->markSelected();
 }
 
 LteMacPdu *LteHarqProcessTx::extractPdu(Codeword cw)
@@ -64,14 +64,14 @@ LteMacPdu *LteHarqProcessTx::extractPdu(Codeword cw)
         throw cRuntimeError("H-ARQ TX process: cannot extract pdu: numSelected = 0 ");
 
     numSelected_--;
-    LteMacPdu *pdu = (*units_)[cw]->extractPdu();
+    LteMacPdu *pdu = units_[cw]->extractPdu();
     return pdu;
 }
 
 bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 {
     // controllare se numempty == numunits e restituire true/false
-    bool reset = (*units_)[cw]->pduFeedback(fb);
+    bool reset = units_[cw]->pduFeedback(fb);
 
     if (reset)
     {
@@ -89,7 +89,7 @@ bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 
 bool LteHarqProcessTx::selfNack(Codeword cw)
 {
-    bool reset = (*units_)[cw]->selfNack();
+    bool reset = units_[cw]->selfNack();
 
     if (reset)
     {
@@ -109,7 +109,7 @@ bool LteHarqProcessTx::hasReadyUnits()
 {
     for (unsigned int i = 0; i < numHarqUnits_; i++)
     {
-        if ((*units_)[i]->isReady())
+        if (units_[i]->isReady())
             return true;
     }
     return false;
@@ -121,9 +121,9 @@ simtime_t LteHarqProcessTx::getOldestUnitTxTime()
     simtime_t curTxTime = 0;
     for (unsigned int i = 0; i < numHarqUnits_; i++)
     {
-        if ((*units_)[i]->isReady())
+        if (units_[i]->isReady())
         {
-            curTxTime = (*units_)[i]->getTxTime();
+            curTxTime = units_[i]->getTxTime();
             if (curTxTime < oldestTxTime)
             {
                 oldestTxTime = curTxTime;
@@ -139,7 +139,7 @@ CwList LteHarqProcessTx::readyUnitsIds()
 
     for (Codeword i = 0; i < numHarqUnits_; i++)
     {
-        if ((*units_)[i]->isReady())
+        if (units_[i]->isReady())
         {
             ul.push_back(i);
         }
@@ -152,7 +152,7 @@ CwList LteHarqProcessTx::emptyUnitsIds()
     CwList ul;
     for (Codeword i = 0; i < numHarqUnits_; i++)
     {
-        if ((*units_)[i]->isEmpty())
+        if (units_[i]->isEmpty())
         {
             ul.push_back(i);
         }
@@ -165,7 +165,7 @@ CwList LteHarqProcessTx::selectedUnitsIds()
     CwList ul;
     for (Codeword i = 0; i < numHarqUnits_; i++)
     {
-        if ((*units_)[i]->isMarked())
+        if (units_[i]->isMarked())
         {
             ul.push_back(i);
         }
@@ -180,19 +180,19 @@ bool LteHarqProcessTx::isEmpty()
 
 LteMacPdu *LteHarqProcessTx::getPdu(Codeword cw)
 {
-    return (*units_)[cw]->getPdu();
+    return units_[cw]->getPdu();
 }
 
 long LteHarqProcessTx::getPduId(Codeword cw)
 {
-    return (*units_)[cw]->getMacPduId();
+    return units_[cw]->getMacPduId();
 }
 
 void LteHarqProcessTx::forceDropProcess()
 {
     for (unsigned int i = 0; i < numHarqUnits_; i++)
     {
-        (*units_)[i]->forceDropUnit();
+        units_[i]->forceDropUnit();
     }
     numEmptyUnits_ = numHarqUnits_;
     numSelected_ = 0;
@@ -201,10 +201,10 @@ void LteHarqProcessTx::forceDropProcess()
 
 bool LteHarqProcessTx::forceDropUnit(Codeword cw)
 {
-    if ((*units_)[cw]->isMarked())
+    if (units_[cw]->isMarked())
         numSelected_--;
 
-    (*units_)[cw]->forceDropUnit();
+    units_[cw]->forceDropUnit();
     numEmptyUnits_++;
 
     // empty process?
@@ -213,43 +213,43 @@ bool LteHarqProcessTx::forceDropUnit(Codeword cw)
 
 TxHarqPduStatus LteHarqProcessTx::getUnitStatus(Codeword cw)
 {
-    return (*units_)[cw]->getStatus();
+    return units_[cw]->getStatus();
 }
 
 void LteHarqProcessTx::dropPdu(Codeword cw)
 {
-    (*units_)[cw]->dropPdu();
+    units_[cw]->dropPdu();
     numEmptyUnits_++;
 }
 
 bool LteHarqProcessTx::isUnitEmpty(Codeword cw)
 {
-    return (*units_)[cw]->isEmpty();
+    return units_[cw]->isEmpty();
 }
 
 bool LteHarqProcessTx::isUnitReady(Codeword cw)
 {
-    return (*units_)[cw]->isReady();
+    return units_[cw]->isReady();
 }
 
 unsigned char LteHarqProcessTx::getTransmissions(Codeword cw)
 {
-    return (*units_)[cw]->getTransmissions();
+    return units_[cw]->getTransmissions();
 }
 
 inet::int64 LteHarqProcessTx::getPduLength(Codeword cw)
 {
-    return (*units_)[cw]->getPduLength();
+    return units_[cw]->getPduLength();
 }
 
 simtime_t LteHarqProcessTx::getTxTime(Codeword cw)
 {
-    return (*units_)[cw]->getTxTime();
+    return units_[cw]->getTxTime();
 }
 
 bool LteHarqProcessTx::isUnitMarked(Codeword cw)
 {
-    return (*units_)[cw]->isMarked();
+    return units_[cw]->isMarked();
 }
 
 bool LteHarqProcessTx::isDropped()
@@ -259,12 +259,10 @@ bool LteHarqProcessTx::isDropped()
 
 LteHarqProcessTx::~LteHarqProcessTx()
 {
-    UnitVector::iterator it = units_->begin();
-    for (; it != units_->end(); ++it)
+    UnitVector::iterator it = units_.begin();
+    for (; it != units_.end(); ++it)
          delete *it;
 
-    units_->clear();
-    delete units_;
-    units_ = NULL;
+    units_.clear();
     macOwner_ = NULL;
 }
@@ -0,0 +1,117 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTEHARQSTATUSMASK_H_
+#define _LTE_LTEHARQSTATUSMASK_H_
+
+#include "common/LteCommon.h"
+
+/// Maximum number of H-ARQ processes that can be tracked by a status mask
+#define HARQ_MASK_MAX_PROCESSES 64
+
+/**
+ * Per-status bitmasks of the units of an H-ARQ buffer.
+ *
+ * For each (status, codeword) pair, bit <acid> is set if the unit of
+ * process <acid> for that codeword is in that status. H-ARQ buffers keep
+ * this structure up to date on every unit status change, so that looking
+ * for a process in a given status is a count-trailing-zeros operation
+ * instead of a scan of all the processes.
+ *
+ * The same class is used for TX (TxHarqPduStatus) and RX (RxHarqPduStatus)
+ * buffers: statuses are handled as plain integers.
+ */
+class LteHarqStatusMask
+{
+  protected:
+    /// masks, indexed by (status * MAX_CODEWORDS + cw)
+    std::vector<uint64_t> masks_;
+
+    /// number of possible statuses
+    unsigned int numStatus_;
+
+  public:
+    LteHarqStatusMask()
+    {
+        numStatus_ = 0;
+    }
+
+    /**
+     * Initializes the masks with all the units in the same status
+     *
+     * @param numProc number of processes of the buffer
+     * @param numStatus number of possible statuses
+     * @param initialStatus status of all the units
+     */
+    LteHarqStatusMask(unsigned int numProc, unsigned int numStatus, unsigned int initialStatus)
+    {
+        if (numProc > HARQ_MASK_MAX_PROCESSES)
+            throw cRuntimeError("LteHarqStatusMask: %u H-ARQ processes, at most %u are supported", numProc, HARQ_MASK_MAX_PROCESSES);
+
+        numStatus_ = numStatus;
+        masks_.assign(numStatus * MAX_CODEWORDS, 0);
+
+        uint64_t all = (numProc == HARQ_MASK_MAX_PROCESSES) ? ~(uint64_t)0 : (((uint64_t)1 << numProc) - 1);
+        for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
+            masks_[initialStatus * MAX_CODEWORDS + cw] = all;
+    }
+
+    /**
+     * Records the new status of a unit
+     *
+     * @param acid process identifier
+     * @param cw codeword of the unit
+     * @param status new status of the unit
+     */
+    void set(unsigned char acid, Codeword cw, unsigned int status)
+    {
+        uint64_t bit = (uint64_t)1 << acid;
+        for (unsigned int s = 0; s < numStatus_; s++)
+            masks_[s * MAX_CODEWORDS + cw] &= ~bit;
+        masks_[status * MAX_CODEWORDS + cw] |= bit;
+    }
+
+    /// @return the processes whose unit for the given codeword is in the given status
+    uint64_t get(unsigned int status, Codeword cw) const
+    {
+        return masks_[status * MAX_CODEWORDS + cw];
+    }
+
+    /// @return the processes having at least one unit in the given status
+    uint64_t getAny(unsigned int status) const
+    {
+        uint64_t mask = 0;
+        for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
+            mask |= masks_[status * MAX_CODEWORDS + cw];
+        return mask;
+    }
+
+    /// @return the processes having all of their units in the given status
+    uint64_t getAll(unsigned int status) const
+    {
+        uint64_t mask = ~(uint64_t)0;
+        for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
+            mask &= masks_[status * MAX_CODEWORDS + cw];
+        return mask;
+    }
+
+    /// @return true if the given unit is in the given status
+    bool test(unsigned char acid, Codeword cw, unsigned int status) const
+    {
+        return (masks_[status * MAX_CODEWORDS + cw] >> acid) & 1;
+    }
+
+    /// @return the lowest acid in the mask, HARQ_NONE if the mask is empty
+    static unsigned char first(uint64_t mask)
+    {
+        return (mask == 0) ? HARQ_NONE : lowestSetBit(mask);
+    }
+};
+
+#endif
@@ -28,6 +28,7 @@ LteHarqBufferRxD2D::LteHarqBufferRxD2D(unsigned int num, LteMacBase *owner, MacN
     {
         processes_[i] = new LteHarqProcessRxD2D(i, macOwner_);
     }
+    initStatusMask();
 
     /* Signals initialization: those are used to gather statistics */
 
@@ -71,14 +72,19 @@ void LteHarqBufferRxD2D::insertPdu(Codeword cw, LteMacPdu *pdu)
     unsigned char acid = uInfo->getAcid();
     // TODO add codeword to inserPdu
     processes_[acid]->insertPdu(cw, pdu);
+    // the MAC will look for correct pdus in this buffer
+    macOwner_->harqRxPending_.insert(nodeId_);
     // debug output
     EV << "H-ARQ RX: new pdu (id " << pdu->getId() << " ) inserted into process " << (int) acid << endl;
 }
 
 void LteHarqBufferRxD2D::sendFeedback()
 {
-    for (unsigned int i = 0; i < numHarqProcesses_; i++)
+    // only processes with a pdu under evaluation can send feedback
+    uint64_t evaluating = statusMask_.getAny(RXHARQ_PDU_EVALUATING);
+    for (; evaluating != 0; evaluating &= evaluating - 1)
     {
+        unsigned int i = lowestSetBit(evaluating);
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
         {
             if (processes_[i]->isEvaluated(cw))
@@ -106,13 +112,18 @@ void LteHarqBufferRxD2D::sendFeedback()
     }
 }
 
-std::list<LteMacPdu *> LteHarqBufferRxD2D::extractCorrectPdus()
+void LteHarqBufferRxD2D::extractCorrectPdus(std::vector<LteMacPdu*>& ret)
 {
     this->sendFeedback();
-    std::list<LteMacPdu*> ret;
+    // NACKed pdus are purged later by the MAC
+    if (statusMask_.getAny(RXHARQ_PDU_CORRUPTED) != 0)
+        macOwner_->harqRxCorrupted_.insert(nodeId_);
+
     unsigned char acid = 0;
-    for (unsigned int i = 0; i < numHarqProcesses_; i++)
+    uint64_t correct = statusMask_.getAny(RXHARQ_PDU_CORRECT);
+    for (; correct != 0; correct &= correct - 1)
     {
+        unsigned int i = lowestSetBit(correct);
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
         {
             if (processes_[i]->isCorrect(cw))
@@ -165,8 +176,6 @@ std::list<LteMacPdu *> LteHarqBufferRxD2D::extractCorrectPdus()
             }
         }
     }
-
-    return ret;
 }
 
 LteHarqBufferRxD2D::~LteHarqBufferRxD2D()
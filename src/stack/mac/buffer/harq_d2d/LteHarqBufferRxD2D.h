@@ -52,13 +52,15 @@ class LteHarqBufferRxD2D : public LteHarqBufferRx
      */
     virtual void insertPdu(Codeword cw, LteMacPdu *pdu);
 
+    using LteHarqBufferRx::extractCorrectPdus;
+
     /**
      * Sends feedback for all processes which are older than
      * HARQ_FB_EVALUATION_INTERVAL, then extract the pdu in correct state (if any)
      *
-     * @return uncorrupted pdus or empty list if none
+     * @param pdus vector where uncorrupted pdus are appended
      */
-    virtual std::list<LteMacPdu*> extractCorrectPdus();
+    virtual void extractCorrectPdus(std::vector<LteMacPdu*>& pdus);
 
     virtual ~LteHarqBufferRxD2D();
 };
@@ -15,12 +15,13 @@ LteHarqBufferTxD2D::LteHarqBufferTxD2D(unsigned int numProc, LteMacBase *owner,
     macOwner_ = owner;
     nodeId_ = dstMac->getMacNodeId();
     selectedAcid_ = HARQ_NONE;
-    processes_ = new std::vector<LteHarqProcessTx *>(numProc);
+    processes_.resize(numProc);
     numEmptyProc_ = numProc;
     for (unsigned int i = 0; i < numProc_; i++)
     {
-        (*processes_)[i] = new LteHarqProcessTxD2D(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
+        processes_[i] = new LteHarqProcessTxD2D(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
     }
+    statusMask_ = LteHarqStatusMask(numProc_, TXHARQ_PDU_SELECTED + 1, TXHARQ_PDU_EMPTY);
 }
 
 void LteHarqBufferTxD2D::receiveHarqFeedback(LteHarqFeedback *fbpkt)
@@ -32,10 +33,10 @@ void LteHarqBufferTxD2D::receiveHarqFeedback(LteHarqFeedback *fbpkt)
     Codeword cw = fbpkt->getCw();
     unsigned char acid = fbpkt->getAcid();
     long fbPduId = fbpkt->getFbMacPduId(); // id of the pdu that should receive this fb
-    long unitPduId = (*processes_)[acid]->getPduId(cw);
+    long unitPduId = processes_[acid]->getPduId(cw);
 
     // After handover or a D2D mode switch, the process nay have been dropped. The received feedback must be ignored.
-    if ((*processes_)[acid]->isDropped())
+    if (processes_[acid]->isDropped())
     {
         EV << "H-ARQ TX buffer: received pdu for acid " << (int)acid << ". The corresponding unit has been "
         " reset after handover or a D2D mode switch (the contained pdu was dropped). Ignore feedback." << endl;
@@ -53,11 +54,12 @@ void LteHarqBufferTxD2D::receiveHarqFeedback(LteHarqFeedback *fbpkt)
         // todo: comment endsim after tests
         throw cRuntimeError("H-ARQ TX: fb is not for the pdu in this unit, maybe the addressed one was dropped");
     }
-    bool reset = (*processes_)[acid]->pduFeedback(harqResult, cw);
+    bool reset = processes_[acid]->pduFeedback(harqResult, cw);
     if (reset)
     {
         numEmptyProc_++;
     }
+    updateStatusMask(acid);
 
     // debug output
     const char *ack = result ? "ACK" : "NACK";
@@ -63,7 +63,7 @@ LteHarqFeedback *LteHarqProcessRxD2D::createFeedback(Codeword cw)
         else
         {
             // NACK will be sent
-            status_.at(cw) = RXHARQ_PDU_CORRUPTED;
+            setStatus(cw, RXHARQ_PDU_CORRUPTED);
 
             EV << "LteHarqProcessRx::createFeedback - tx number " << (unsigned int)transmissions_ << endl;
             if (transmissions_ == (maxHarqRtx_ + 1))
@@ -78,7 +78,7 @@ LteHarqFeedback *LteHarqProcessRxD2D::createFeedback(Codeword cw)
     }
     else
     {
-        status_.at(cw) = RXHARQ_PDU_CORRECT;
+        setStatus(cw, RXHARQ_PDU_CORRECT);
     }
 
     return fb;
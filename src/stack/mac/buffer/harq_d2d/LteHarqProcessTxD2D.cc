@@ -14,7 +14,7 @@ LteHarqProcessTxD2D::LteHarqProcessTxD2D(unsigned char acid, unsigned int numUni
     macOwner_ = macOwner;
     acid_ = acid;
     numHarqUnits_ = numUnits;
-    units_ = new UnitVector(numUnits);
+    units_.resize(numUnits);
     numProcesses_ = numProcesses;
     numEmptyUnits_ = numUnits; //++ @ insert, -- @ unit reset (ack or fourth nack)
     numSelected_ = 0; //++ @ markSelected and insert, -- @ extract/sendDown
@@ -22,7 +22,7 @@ LteHarqProcessTxD2D::LteHarqProcessTxD2D(unsigned char acid, unsigned int numUni
     // H-ARQ unit istances
     for (unsigned int i = 0; i < numHarqUnits_; i++)
     {
-        (*units_)[i] = new LteHarqUnitTxD2D(acid, i, macOwner_, dstMac);
+        units_[i] = new LteHarqUnitTxD2D(acid, i, macOwner_, dstMac);
     }
 }
 
@@ -36,7 +36,7 @@ LteMacPdu *LteHarqProcessTxD2D::extractPdu(Codeword cw)
         throw cRuntimeError("H-ARQ TX process: cannot extract pdu: numSelected = 0 ");
 
     numSelected_--;
-    LteMacPdu *pdu = (*units_)[cw]->extractPdu();
+    LteMacPdu *pdu = units_[cw]->extractPdu();
     if (check_and_cast<LteControlInfo*>(pdu->getControlInfo())->getDirection() == D2D_MULTI)
     {
         // if the pdu is for a multicast/broadcast connection, the selected unit has been emptied
@@ -12,6 +12,8 @@
 #include "stack/phy/ChannelModel/LteRealisticChannelModel.h"
 #include "stack/phy/layer/LtePhyBase.h"
 #include <iomanip>
+#include <algorithm>
+#include <math.h>
 #define NIL -1
 
 /*!
@@ -22,6 +24,10 @@
 
 MeshMaster::MeshMaster() {
     connectivityMatrix.clear();
+    numUe_ = 0;
+    numWords_ = 0;
+    moveThreshold_ = 0;
+    maxDistance_ = 0;
 }
 
 /*!
@@ -29,11 +35,17 @@ MeshMaster::MeshMaster() {
  * \memberof MeshMaster
  * \brief class constructor;
  * \param eNbScheduler pointer to the eNodeB scheduler
+ * \param moveThreshold minimum movement of a UE that triggers the update of its received powers
+ * \param maxDistance maximum distance between two UEs to be evaluated as a couple (<= 0 for all couples)
  */
 
-MeshMaster::MeshMaster(LteMacEnb* macEnb, double conflictThreshold)
+MeshMaster::MeshMaster(LteMacEnb* macEnb, double conflictThreshold, double moveThreshold, double maxDistance)
 {
     connectivityMatrix.clear();
+    numUe_ = 0;
+    numWords_ = 0;
+    moveThreshold_ = moveThreshold;
+    maxDistance_ = maxDistance;
 
     // Get the reference to the eNodeB MAC Layer
     mac_ = macEnb;
@@ -58,14 +70,6 @@ MeshMaster::~MeshMaster()
     connectivityMatrix.clear();
     conflictMap_.clear();
 }
-/**
- * Clean all Mesh Master structure
- */
-void MeshMaster::cleanMeshMaster()
-{
-    connectivityMatrix.clear();
-    conflictMap_.clear();
-}
 /*!
  * \fn initRecPwrStruct
  * \memberof MeshMaster
@@ -78,27 +82,29 @@ void MeshMaster::initRecPwrStruct()
 {
     EV << "\tinitRecPwrStruct::\tInitialize Receive Power Structure" << endl;
     // Get the number of all the UEs in the Cell
-    unsigned int num_ue = getBinder()->getUeList()->size();
-    // For each UE in the Cell
-    for (unsigned int i = 0; i < num_ue; i++)
+    numUe_ = getBinder()->getUeList()->size();
+    // No self interference is possible: the diagonal is kept to -1
+    recvPower_.assign(numUe_ * numUe_, -1);
+    changedPairs_.clear();
+    lastPosition_.assign(numUe_, Coord());
+    positionKnown_.assign(numUe_, false);
+    currentPosition_.assign(numUe_, Coord());
+
+    ueInfo_.assign(numUe_, NULL);
+    std::vector<UeInfo*>::const_iterator it = getBinder()->getUeList()->begin();
+    std::vector<UeInfo*>::const_iterator et = getBinder()->getUeList()->end();
+    for (;it!=et;++it)
     {
-        // Create a new power vector
-        PWRvector* tmpVector = new PWRvector[num_ue];
-        // Initialize the "value" field of the PWRvector
-        for (unsigned int var = 0; var < num_ue; ++var)
-        {
-            tmpVector[var].id_ = var;
-            // Get the node id for the transmitter check
-            MacNodeId nodeId = indexToNodeId(i);
-            // Get the node Id for the receiver check
-            MacNodeId nodeId2 = indexToNodeId(var);
-
-            if (nodeId == nodeId2)
-                tmpVector[var].value = -1;
-        }
-        pair<unsigned int, PWRvector*> tmp = pair<unsigned int, PWRvector*>(i, tmpVector);
-        RPAntenna.insert(tmp);
+        unsigned int index = nodeIdToIndex((*it)->id);
+        if (index >= numUe_)
+            throw cRuntimeError("MeshMaster::initRecPwrStruct - UE %d out of the index range", (*it)->id);
+        ueInfo_[index] = *it;
     }
+
+    // adjacency bitsets
+    numWords_ = (numUe_ + 63) / 64;
+    conflictBits_.assign(numUe_ * numWords_, 0);
+    connectivityBits_.assign(numUe_ * numWords_, 0);
 }
 
 
@@ -106,64 +112,137 @@ void MeshMaster::initRecPwrStruct()
  * \fn recPwrStructPrint()
  * \memberof MeshMaster
  * \brief calculate the received power for each couple of antenna 
- *      in the mesh, stores information in the structure RPAntenna
- *  RPAntenna structure must be initialized
+ *      in the mesh, stores information in the structure recvPower_
+ *  recvPower_ structure must be initialized.
+ *  If moveThreshold_ is set, only the couples where at least one UE moved more
+ *  than moveThreshold_ since its last update are recomputed, otherwise all the
+ *  couples are. The recomputed couples are recorded in changedPairs_
  */
 
 void MeshMaster::computeRecPwrStruct()
 {
     EV << "\tMeshMaster::\t\tComputing Receiver Power Structure" << endl;
-    std::vector<UeInfo*>::const_iterator it = getBinder()->getUeList()->begin();
-    std::vector<UeInfo*>::const_iterator et = getBinder()->getUeList()->end();
-    ///compute the received power for all the Receivers
+    std::vector<UeInfo*>* ueList = getBinder()->getUeList();
+    changedPairs_.clear();
+
+    // find the UEs that moved since their last update (all of them, without a threshold)
+    std::vector<bool> moved(numUe_, false);
+    std::vector<UeInfo*>::const_iterator it = ueList->begin();
+    std::vector<UeInfo*>::const_iterator et = ueList->end();
     for (;it!=et;++it)
     {
-        computeAntennaRecvPwr((*it)->id);
+        unsigned int index = nodeIdToIndex((*it)->id);
+        if (index >= numUe_)
+            continue;   // UE added after initialization
+        currentPosition_[index] = mac_->getDeployer()->getUePosition((*it)->id);
+        if (moveThreshold_ <= 0 || !positionKnown_[index] || currentPosition_[index].distance(lastPosition_[index]) > moveThreshold_)
+        {
+            moved[index] = true;
+            positionKnown_[index] = true;
+            lastPosition_[index] = currentPosition_[index];
+        }
+    }
+
+    std::vector<std::vector<unsigned int> > candidates;
+    computeCandidates(candidates);
+
+    ///compute the received power for all the Receivers
+    for (it = ueList->begin();it!=et;++it)
+    {
+        unsigned int index = nodeIdToIndex((*it)->id);
+        if (index >= numUe_)
+            continue;
+        // without maxDistance_, the single list of all UEs is shared by every receiver
+        computeAntennaRecvPwr((*it)->id, (maxDistance_ <= 0) ? candidates[0] : candidates[index], moved);
     }
 }
 
 /*!
- * \fn computeAntennaRecvPwr(EnbId id)
+ * \fn computeCandidates()
  * \memberof MeshMaster
- * \brief calculate the received power between the antenna "id"(receiver) and 
- * all the others antennas inside the mesh network, stores information in RPAntenna
- * \param id id of the antenna
+ * \brief for each UE, find the UEs that can be in conflict with it.
+ *  If maxDistance_ is set, UEs are placed in a grid of cells of side maxDistance_
+ *  and only the UEs in the same or neighbouring cells within maxDistance_ are returned,
+ *  otherwise a single list containing all UEs is returned, valid for every UE
  */
-void MeshMaster::computeAntennaRecvPwr(MacNodeId nodeId)
+void MeshMaster::computeCandidates(std::vector<std::vector<unsigned int> >& candidates)
 {
-    // Get the index from the nodeId
-    unsigned int id = nodeIdToIndex(nodeId);
-    double tmp = 0;
+    candidates.clear();
 
-    // et points at the right position of RPAntenna
-    std::map<unsigned int, PWRvector*>::const_iterator et_id = RPAntenna.find(id);
-
-    if (et_id == RPAntenna.end()) {
-        cout << "MeshMaster:: " << endl;
-        cout << "\tcomputeAntennaRecvPwr - Cannot find the antenna [id : " << id << " ]" << endl;
-        exit(1);
+    if (maxDistance_ <= 0)
+    {
+        candidates.resize(1, std::vector<unsigned int>(numUe_));
+        for (unsigned int i = 0; i < numUe_; i++)
+            candidates[0][i] = i;
+        return;
     }
 
-    // Set the iterators
-    std::vector<UeInfo*>::const_iterator it = getBinder()->getUeList()->begin();
-    std::vector<UeInfo*>::const_iterator et = getBinder()->getUeList()->end();
+    candidates.resize(numUe_);
 
-    // Compute the SNR for all the transmitters
-    for (;it!=et;++it)
+    // place the UEs in the grid
+    std::map<std::pair<int, int>, std::vector<unsigned int> > grid;
+    for (unsigned int i = 0; i < numUe_; i++)
     {
-        if (nodeId != (*it)->id)
+        if (!positionKnown_[i])
+            continue;
+        std::pair<int, int> cell((int) floor(currentPosition_[i].x / maxDistance_), (int) floor(currentPosition_[i].y / maxDistance_));
+        grid[cell].push_back(i);
+    }
+
+    // look for candidates in the neighbouring cells
+    for (unsigned int i = 0; i < numUe_; i++)
+    {
+        if (!positionKnown_[i])
+            continue;
+        int cx = (int) floor(currentPosition_[i].x / maxDistance_);
+        int cy = (int) floor(currentPosition_[i].y / maxDistance_);
+        for (int dx = -1; dx <= 1; dx++)
         {
-            // Get the received power
-            tmp = computeReceivedPower(nodeId,(*it)->id);
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                std::map<std::pair<int, int>, std::vector<unsigned int> >::const_iterator cit = grid.find(std::make_pair(cx + dx, cy + dy));
+                if (cit == grid.end())
+                    continue;
+                for (unsigned int k = 0; k < cit->second.size(); k++)
+                {
+                    unsigned int j = cit->second[k];
+                    if (currentPosition_[i].distance(currentPosition_[j]) <= maxDistance_)
+                        candidates[i].push_back(j);
+                }
+            }
         }
-        // Get the index from the nodeId
-        unsigned int index = nodeIdToIndex((*it)->id);
-        if(index == id)
-            et_id->second[index].value = -1; // No self interference is possible
-        else
-            et_id->second[index].value = tmp; // Set the receiving power
-        // Set the id
-        et_id->second[index].id_ = index;
+        // keep the same evaluation order of the full computation
+        std::sort(candidates[i].begin(), candidates[i].end());
+    }
+}
+
+/*!
+ * \fn computeAntennaRecvPwr(EnbId id)
+ * \memberof MeshMaster
+ * \brief calculate the received power between the antenna "id"(receiver) and 
+ * the given transmitters, stores information in recvPower_.
+ * Couples where neither UE moved are skipped
+ * \param id id of the antenna
+ * \param transmitters indices of the candidate transmitters
+ * \param moved flag for each UE, set if the UE moved since its last update
+ */
+void MeshMaster::computeAntennaRecvPwr(MacNodeId nodeId, const std::vector<unsigned int>& transmitters, const std::vector<bool>& moved)
+{
+    // Get the index from the nodeId
+    unsigned int id = nodeIdToIndex(nodeId);
+
+    // Compute the SNR for the transmitters
+    for (unsigned int k = 0; k < transmitters.size(); k++)
+    {
+        unsigned int index = transmitters[k];
+        if (index == id)
+            continue; // No self interference is possible
+        if (!moved[id] && !moved[index])
+            continue; // the received power did not change
+
+        // Get the received power
+        recvPower_[id * numUe_ + index] = computeReceivedPower(nodeId, indexToNodeId(index));
+        changedPairs_.push_back(id * numUe_ + index);
     }
 }
 
@@ -175,16 +254,24 @@ void MeshMaster::computeAntennaRecvPwr(MacNodeId nodeId)
  */
 double MeshMaster::computeReceivedPower(MacNodeId receiver_nodeId,MacNodeId transmitter_nodeId)
 {
+    // Get the UE info of the transmitter
+    UeInfo* transmitter = ueInfo_[nodeIdToIndex(transmitter_nodeId)];
+
     // Reference to the Physical Channel  of the transmitter
-    LtePhyBase* transmitter_ltePhy;
-    // Get the Physical Channel reference of the interfering node
-    transmitter_ltePhy = check_and_cast<LtePhyBase*>(getSimulation()->getModule(getBinder()->getOmnetId(transmitter_nodeId))->getSubmodule("lteNic")->getSubmodule("phy"));
+    LtePhyBase* transmitter_ltePhy = transmitter->phy;
+    // initialize UE data structures
+    if (!transmitter->init)
+    {
+        // get real Channel
+        transmitter->realChan = dynamic_cast<LteRealisticChannelModel *>(transmitter_ltePhy->getChannelModel());
+        transmitter->init = true;
+    }
     // Get the transmission power
     double TxPower = transmitter_ltePhy->getTxPwr();
     // Get the Real Channel reference of the transmitter
-    LteRealisticChannelModel* transmitter_realChan = dynamic_cast<LteRealisticChannelModel *>(transmitter_ltePhy->getChannelModel());
+    LteRealisticChannelModel* transmitter_realChan = transmitter->realChan;
     // Get the receiver's position
-    Coord receiver_coord = mac_->getDeployer()->getUePosition(receiver_nodeId);
+    Coord receiver_coord = currentPosition_[nodeIdToIndex(receiver_nodeId)];
     // Compute attenuation using data structures within the Macro Cell.
     double att = transmitter_realChan->getAttenuation(receiver_nodeId,UL,receiver_coord); // TODO: check if the attenuation is right
     double txPwr = TxPower - cableLoss_ + antennaGainUe_;
@@ -194,6 +281,25 @@ double MeshMaster::computeReceivedPower(MacNodeId receiver_nodeId,MacNodeId tran
     return rxPwr;
 }
 
+bool MeshMaster::setEdgeBit(std::vector<uint64_t>& bits, unsigned int tx, unsigned int rx)
+{
+    uint64_t& word = bits[tx * numWords_ + rx / 64];
+    uint64_t bit = (uint64_t)1 << (rx % 64);
+    if (word & bit)
+        return false;
+    word |= bit;
+    return true;
+}
+
+bool MeshMaster::isConflicting(MacNodeId tx, MacNodeId rx) const
+{
+    unsigned int t = nodeIdToIndex(tx);
+    unsigned int r = nodeIdToIndex(rx);
+    if (t >= numUe_ || r >= numUe_)
+        return false;
+    return (conflictBits_[t * numWords_ + r / 64] >> (r % 64)) & 1;
+}
+
 /*!
  * \fn computeMatrixDimension()
  * \memberof MeshMaster
@@ -210,42 +316,32 @@ int MeshMaster::computeMatrixDimension() {
  * \fn computeConnGraph()
  * \memberof MeshMaster
  * \brief compute the connectivity Graph of the network evaluating received power
- *  between antennas
+ *  between antennas. Only the couples updated by the last computeRecPwrStruct()
+ *  are evaluated: edges are never removed from the graph
  */
 void MeshMaster::computeConnGraph()
 {
     Edge tmpEdge;
-    // Get the number of all the UEs in the Cell
-    unsigned int num_ue = getBinder()->getUeList()->size();
-    int j = 0;
-    for (std::map <unsigned int, PWRvector*>::const_iterator it = RPAntenna.begin(); it != RPAntenna.end(); it++)
+    for (unsigned int k = 0; k < changedPairs_.size(); k++)
     {
-        for (unsigned int i = 0; i < num_ue; i++)
+        unsigned int j = changedPairs_[k];
+        tmpEdge.ric = j / numUe_;
+        tmpEdge.mit = j % numUe_;
+        tmpEdge.value = recvPower_[j];
+
+        /// if the recv power is -1
+        if (tmpEdge.value == -1)
+            continue;
+
+        /* If the received power is greater than the treshold, the antennas 
+         * can communicate each other. Insert that couple in the connectivity 
+         * graph.
+         */
+        if (tmpEdge.value > connectivityTh && setEdgeBit(connectivityBits_, tmpEdge.mit, tmpEdge.ric))
         {
-            tmpEdge.ric = it->first;
-            tmpEdge.mit = it->second[i].id_;
-            //tmpEdge.value = channelMaster_->computeReceivedPower(it->second[i].id_, enbRic->getPosition(), LOS_ALL);
-            tmpEdge.value = it->second[i].value;
-
-            /// if the receiver is equal to the transmitter or the recv power is -1
-            if (it->second[i].id_ == it->first || it->second[i].value==-1)
-            {
-                j++;
-                continue;
-            }
-
-            /* If the received power is greater than the treshold, the antennas 
-             * can communicate each other. Insert that couple in the connectivity 
-             * graph.
-             */
-            if (it->second[i].value > connectivityTh)
-            {
-                //insert the couple in the conflict graph
-                //insert the receiver
-                pair<unsigned int, Edge> tmp = pair<unsigned int, Edge>(j, tmpEdge);
-                connectivityGraph.insert(tmp);
-            }
-            j++;
+            //insert the couple in the connectivity graph
+            pair<unsigned int, Edge> tmp = pair<unsigned int, Edge>(j, tmpEdge);
+            connectivityGraph.insert(tmp);
         }
     }
 }
@@ -317,34 +413,24 @@ void MeshMaster::printGraph(GraphType graph) {
 void MeshMaster::computeConflictEdge(double treshold)
 {
     Edge tmpEdge;
-    int j = 0;
-
-    // Get the number of all the UEs in the Cell
-    unsigned int num_ue = getBinder()->getUeList()->size();
 
-    // For all the node in the RecvPower struct
-    for (std::map<unsigned int, PWRvector*>::const_iterator it = RPAntenna.begin(); it != RPAntenna.end(); it++)
+    // For all the couples updated in the RecvPower struct
+    for (unsigned int k = 0; k < changedPairs_.size(); k++)
     {
-        for (unsigned int i = 0; i < num_ue; i++)
+        unsigned int j = changedPairs_[k];
+        if (recvPower_[j] == -1 )
+            continue;
+        // Extract the parameters
+        tmpEdge.mit = j % numUe_;
+        tmpEdge.ric = j / numUe_;
+        tmpEdge.value = recvPower_[j];
+        // If the value is above the threshold insert the pair in the conflict graph (once)
+        if ((tmpEdge.value > treshold ) && setEdgeBit(conflictBits_, tmpEdge.mit, tmpEdge.ric)) // || getBinder()->checkD2DCapability(indexToNodeId(tmpEdge.mit), indexToNodeId(tmpEdge.ric)) )   // peering UEs are in conflict
         {
-            if (it->second[i].value == -1 )
-            {
-                j++;
-                continue;
-            }
-            // Extract the parameters
-            tmpEdge.mit = it->second[i].id_;
-            tmpEdge.ric = it->first;
-            tmpEdge.value = it->second[i].value;
             // Creates the pair
             pair<unsigned int, Edge> tmp = pair<unsigned int, Edge>(j, tmpEdge);
-            // If the value is above the threshold insert the pair in the conflict graph
-            if ((it->second[i].value > treshold ) ) // || getBinder()->checkD2DCapability(indexToNodeId(tmpEdge.mit), indexToNodeId(tmpEdge.ric)) )   // peering UEs are in conflict
-            {
-                conflictGraph.insert(tmp);
-                conflictMap_[indexToNodeId(tmpEdge.mit)].insert(indexToNodeId(tmpEdge.ric));
-            }
-            j++;
+            conflictGraph.insert(tmp);
+            conflictMap_[indexToNodeId(tmpEdge.mit)].insert(indexToNodeId(tmpEdge.ric));
         }
     }
 }
@@ -24,8 +24,36 @@
 
 class MeshMaster {
     
-    RecPwrMatrix RPAntenna;             ///for each couple of antenna stores the received power
-    
+    /// number of UEs handled by the structures (UEs registered at initialization)
+    unsigned int numUe_;
+
+    /// received power for each couple of UEs, indexed by (receiver index * numUe_ + transmitter index)
+    std::vector<double> recvPower_;
+
+    /// couples of UEs (same indexing of recvPower_) whose received power changed in the last update
+    std::vector<unsigned int> changedPairs_;
+
+    /// UE info of each UE, indexed by UE index
+    std::vector<UeInfo*> ueInfo_;
+
+    /// position of each UE at the last update of its received powers
+    std::vector<inet::Coord> lastPosition_;
+    std::vector<bool> positionKnown_;
+
+    /// position of each UE at the current update
+    std::vector<inet::Coord> currentPosition_;
+
+    /// minimum movement of a UE that triggers the update of its received powers (m). If <= 0, all couples are updated
+    double moveThreshold_;
+
+    /// maximum distance between two UEs for them to be evaluated as a couple (m). If <= 0, all couples are evaluated
+    double maxDistance_;
+
+    /// adjacency bitsets, one row of numWords_ words for each transmitter: bit <rx> is set if tx->rx is an edge
+    std::vector<uint64_t> conflictBits_;
+    std::vector<uint64_t> connectivityBits_;
+    unsigned int numWords_;
+
     Graph conflictGraph;
     Graph connectivityGraph;
     
@@ -46,7 +74,7 @@ class MeshMaster {
 public:
    
     MeshMaster();
-    MeshMaster(LteMacEnb* macEnb, double conflictThreshold);
+    MeshMaster(LteMacEnb* macEnb, double conflictThreshold, double moveThreshold = 0, double maxDistance = 0);
     virtual ~MeshMaster();
     
     //receive power structure
@@ -74,17 +102,26 @@ public:
 
     int getEdgeNumber() {return connectivityGraph.size();}
     
-    void cleanMeshMaster();
     // Return a reference to the conflict map
     const std::map<MacNodeId,std::set<MacNodeId> >* getConflictMap();
 
+    // Return true if the transmission of <tx> interferes with the reception of <rx>
+    bool isConflicting(MacNodeId tx, MacNodeId rx) const;
+
     // initialize all the structure
     bool initStructure();
     void computeStruct();
     
 private:
 
-    void computeAntennaRecvPwr(MacNodeId nodeId);
+    void computeAntennaRecvPwr(MacNodeId nodeId, const std::vector<unsigned int>& transmitters, const std::vector<bool>& moved);
+
+    /// returns, for each UE, the indices of the UEs within maxDistance_ (sorted), using a grid of cells of side maxDistance_.
+    /// If maxDistance_ <= 0, returns a single list of all the UEs, shared by every UE
+    void computeCandidates(std::vector<std::vector<unsigned int> >& candidates);
+
+    /// sets bit <rx> in row <tx> of the given bitsets, returns false if it was already set
+    bool setEdgeBit(std::vector<uint64_t>& bits, unsigned int tx, unsigned int rx);
     int computeMatrixDimension();
 
     /// utility function used to compute the conflict graph
@@ -288,6 +288,8 @@ void LteMacBase::deleteQueues(MacNodeId nodeId)
             ++hit2;
         }
     }
+    harqRxPending_.erase(nodeId);
+    harqRxCorrupted_.erase(nodeId);
 
     // TODO remove traffic descriptor and lcg entry
 }
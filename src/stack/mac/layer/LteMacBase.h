@@ -115,6 +115,12 @@ class LteMacBase : public cSimpleModule
     /// Harq Rx Buffers
     HarqRxBuffers harqRxBuffers_;
 
+    /// Harq Rx Buffers having pdus under evaluation or ready to be extracted
+    std::set<MacNodeId> harqRxPending_;
+
+    /// Harq Rx Buffers having corrupted pdus to be purged
+    std::set<MacNodeId> harqRxCorrupted_;
+
     /* Connection Descriptors
      * Holds flow related infos
      */
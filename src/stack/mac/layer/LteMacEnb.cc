@@ -661,22 +661,8 @@ void LteMacEnb::handleSelfMessage()
 
     /* Reception */
 
-    // extract pdus from all harqrxbuffers and pass them to unmaker
-    HarqRxBuffers::iterator hit = harqRxBuffers_.begin();
-    HarqRxBuffers::iterator het = harqRxBuffers_.end();
-    LteMacPdu *pdu = NULL;
-    std::list<LteMacPdu*> pduList;
-
-    for (; hit != het; hit++)
-    {
-        pduList = hit->second->extractCorrectPdus();
-        while (!pduList.empty())
-        {
-            pdu = pduList.front();
-            pduList.pop_front();
-            macPduUnmake(pdu);
-        }
-    }
+    // extract pdus from harqrxbuffers and pass them to unmaker
+    extractHarqRxPdus();
 
     /*UPLINK*/
     EV << "============================================== UPLINK ==============================================" << endl;
@@ -708,10 +694,7 @@ void LteMacEnb::handleSelfMessage()
     EV << "========================================== END DOWNLINK ============================================" << endl;
 
     // purge from corrupted PDUs all Rx H-HARQ buffers for all users
-    for (hit = harqRxBuffers_.begin(); hit != het; hit++)
-    {
-        hit->second->purgeCorruptedPdus();
-    }
+    purgeHarqRxPdus();
 
     // flush Tx H-ARQ buffers for all users
     HarqTxBuffers::iterator it;
@@ -721,15 +704,54 @@ void LteMacEnb::handleSelfMessage()
     EV << "--- END " << ((nodeType==MACRO_ENB)?"MACRO":"MICRO") << " ENB MAIN LOOP ---" << endl;
 }
 
+void LteMacEnb::extractHarqRxPdus()
+{
+    std::set<MacNodeId>::iterator it = harqRxPending_.begin();
+    while (it != harqRxPending_.end())
+    {
+        HarqRxBuffers::iterator hit = harqRxBuffers_.find(*it);
+        if (hit == harqRxBuffers_.end())
+        {
+            // the buffer has been deleted
+            harqRxPending_.erase(it++);
+            continue;
+        }
+
+        LteHarqBufferRx* buffer = hit->second;
+        buffer->extractCorrectPdus(rxPdus_);
+        for (unsigned int i = 0; i < rxPdus_.size(); i++)
+            macPduUnmake(rxPdus_[i]);
+        rxPdus_.clear();
+
+        // the buffer stays in the list until all of its pdus have been evaluated
+        if (buffer->hasPendingPdus())
+            ++it;
+        else
+            harqRxPending_.erase(it++);
+    }
+}
+
+void LteMacEnb::purgeHarqRxPdus()
+{
+    std::set<MacNodeId>::iterator it = harqRxCorrupted_.begin();
+    for (; it != harqRxCorrupted_.end(); ++it)
+    {
+        HarqRxBuffers::iterator hit = harqRxBuffers_.find(*it);
+        if (hit != harqRxBuffers_.end())
+            hit->second->purgeCorruptedPdus();
+    }
+    harqRxCorrupted_.clear();
+}
+
 void LteMacEnb::macHandleFeedbackPkt(cPacket *pkt)
 {
     LteFeedbackPkt* fb = check_and_cast<LteFeedbackPkt*>(pkt);
-    LteFeedbackDoubleVector fbMapDl = fb->getLteFeedbackDoubleVectorDl();
-    LteFeedbackDoubleVector fbMapUl = fb->getLteFeedbackDoubleVectorUl();
+    const LteFeedbackDoubleVector& fbMapDl = fb->getLteFeedbackDoubleVectorDl();
+    const LteFeedbackDoubleVector& fbMapUl = fb->getLteFeedbackDoubleVectorUl();
     //get Source Node Id<
     MacNodeId id = fb->getSourceNodeId();
-    LteFeedbackDoubleVector::iterator it;
-    LteFeedbackVector::iterator jt;
+    LteFeedbackDoubleVector::const_iterator it;
+    LteFeedbackVector::const_iterator jt;
 
     for (it = fbMapDl.begin(); it != fbMapDl.end(); ++it)
     {
@@ -78,6 +78,9 @@ class LteMacEnb : public LteMacBase
     // conflict graph builder
     MeshMaster* meshMaster_;
 
+    /// Pdus extracted from an H-ARQ RX buffer, reused at every TTI
+    std::vector<LteMacPdu*> rxPdus_;
+
     /**
      * Reads MAC parameters for eNb and performs initialization.
      */
@@ -138,6 +141,18 @@ class LteMacEnb : public LteMacBase
      */
     virtual void handleUpperMessage(cPacket* pkt);
 
+    /**
+     * Extracts correct pdus from the H-ARQ RX buffers and passes them to
+     * macPduUnmake(). Only the buffers that registered pdus under evaluation
+     * are visited, in increasing nodeId order.
+     */
+    void extractHarqRxPdus();
+
+    /**
+     * Purges corrupted pdus from the H-ARQ RX buffers that registered some
+     */
+    void purgeHarqRxPdus();
+
     /**
      * Main loop
      */
@@ -305,7 +320,7 @@ class LteMacEnb : public LteMacBase
      */
     ActiveSet getActiveSet(Direction dir);
 
-    void cqiStatistics(MacNodeId id, Direction dir, LteFeedback fb);
+    void cqiStatistics(MacNodeId id, Direction dir, const LteFeedback& fb);
 
     // get band occupation for this/previous TTI. Used for interference computation purposes
     unsigned int getBandStatus(Band b);
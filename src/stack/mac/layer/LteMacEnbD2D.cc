@@ -54,16 +54,16 @@ void LteMacEnbD2D::initialize(int stage)
 void LteMacEnbD2D::macHandleFeedbackPkt(cPacket *pkt)
 {
     LteFeedbackPkt* fb = check_and_cast<LteFeedbackPkt*>(pkt);
-    std::map<MacNodeId, LteFeedbackDoubleVector> fbMapD2D = fb->getLteFeedbackDoubleVectorD2D();
+    const std::map<MacNodeId, LteFeedbackDoubleVector>& fbMapD2D = fb->getLteFeedbackDoubleVectorD2D();
 
     // skip if no D2D CQI has been reported
     if (!fbMapD2D.empty())
     {
         //get Source Node Id<
         MacNodeId id = fb->getSourceNodeId();
-        std::map<MacNodeId, LteFeedbackDoubleVector>::iterator mapIt;
-        LteFeedbackDoubleVector::iterator it;
-        LteFeedbackVector::iterator jt;
+        std::map<MacNodeId, LteFeedbackDoubleVector>::const_iterator mapIt;
+        LteFeedbackDoubleVector::const_iterator it;
+        LteFeedbackVector::const_iterator jt;
 
         // extract feedback for D2D links
         for (mapIt = fbMapD2D.begin(); mapIt != fbMapD2D.end(); ++mapIt)
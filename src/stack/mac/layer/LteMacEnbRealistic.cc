@@ -384,22 +384,10 @@ void LteMacEnbRealistic::handleSelfMessage()
 
     /* Reception */
 
-    // extract pdus from all harqrxbuffers and pass them to unmaker
-    HarqRxBuffers::iterator hit = harqRxBuffers_.begin();
-    HarqRxBuffers::iterator het = harqRxBuffers_.end();
-    LteMacPdu *pdu = NULL;
-    std::list<LteMacPdu*> pduList;
-
-    for (; hit != het; hit++)
-    {
-        pduList = hit->second->extractCorrectPdus();
-        while (!pduList.empty())
-        {
-            pdu = pduList.front();
-            pduList.pop_front();
-            macPduUnmake(pdu);
-        }
-    }
+    // extract pdus from harqrxbuffers and pass them to unmaker
+    extractHarqRxPdus();
+    // this MAC does not purge corrupted pdus from the H-ARQ RX buffers: drop the list of their buffers
+    harqRxCorrupted_.clear();
 
     /*UPLINK*/
     EV << "============================================== UPLINK ==============================================" << endl;
@@ -435,12 +423,6 @@ void LteMacEnbRealistic::handleSelfMessage()
     }
     EV << "========================================== END DOWNLINK ============================================" << endl;
 
-    // purge from corrupted PDUs all Rx H-HARQ buffers for all users
-    for (; hit != het; hit++)
-    {
-        hit->second->purgeCorruptedPdus();
-    }
-
     // Message that triggers flushing of Tx H-ARQ buffers for all users
     // This way, flushing is performed after the (possible) reception of new MAC PDUs
     cMessage* flushHarqMsg = new cMessage("flushHarqMsg");
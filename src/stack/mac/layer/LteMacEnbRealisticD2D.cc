@@ -51,8 +51,10 @@ void LteMacEnbRealisticD2D::initialize(int stage)
         {
             conflictGraphUpdatePeriod_ = par("conflictGraphUpdatePeriod");
             conflictGraphThreshold_ = par("conflictGraphThreshold");
+            double conflictGraphMoveThreshold = par("conflictGraphMoveThreshold");
+            double conflictGraphMaxDistance = par("conflictGraphMaxDistance");
 
-            meshMaster_ = new MeshMaster(this, conflictGraphThreshold_);
+            meshMaster_ = new MeshMaster(this, conflictGraphThreshold_, conflictGraphMoveThreshold, conflictGraphMaxDistance);
             meshMaster_->initStructure();
             scheduleAt(NOW + 0.05, new cMessage("updateConflictGraph"));
         }
@@ -62,16 +64,16 @@ void LteMacEnbRealisticD2D::initialize(int stage)
 void LteMacEnbRealisticD2D::macHandleFeedbackPkt(cPacket *pkt)
 {
     LteFeedbackPkt* fb = check_and_cast<LteFeedbackPkt*>(pkt);
-    std::map<MacNodeId, LteFeedbackDoubleVector> fbMapD2D = fb->getLteFeedbackDoubleVectorD2D();
+    const std::map<MacNodeId, LteFeedbackDoubleVector>& fbMapD2D = fb->getLteFeedbackDoubleVectorD2D();
 
     // skip if no D2D CQI has been reported
     if (!fbMapD2D.empty())
     {
         //get Source Node Id<
         MacNodeId id = fb->getSourceNodeId();
-        std::map<MacNodeId, LteFeedbackDoubleVector>::iterator mapIt;
-        LteFeedbackDoubleVector::iterator it;
-        LteFeedbackVector::iterator jt;
+        std::map<MacNodeId, LteFeedbackDoubleVector>::const_iterator mapIt;
+        LteFeedbackDoubleVector::const_iterator it;
+        LteFeedbackVector::const_iterator jt;
 
         // extract feedback for D2D links
         for (mapIt = fbMapD2D.begin(); mapIt != fbMapD2D.end(); ++mapIt)
@@ -107,12 +107,14 @@ void LteMacUe::initialize(int stage)
         info->ue = this->getParentModule()->getParentModule();  // reference to the UE module
 
         // Get the Physical Channel reference of the node
-        info->phy = check_and_cast<LtePhyBase*>(info->ue->getSubmodule("lteNic")->getSubmodule("phy"));
+        info->phy = binder_->getPhyFromMacNodeId(nodeId_);
+        if (info->phy == NULL)
+            throw cRuntimeError("LteMacUe::initialize - cannot find the PHY module of node %d", nodeId_);
 
         binder_->addUeInfo(info);
 
         // only for UEs that have been added dynamically to the simulation
-        LteAmc *amc = check_and_cast<LteMacEnb *>(getSimulation()->getModule(binder_->getOmnetId(cellId_))->getSubmodule("lteNic")->getSubmodule("mac"))->getAmc();
+        LteAmc *amc = check_and_cast<LteMacEnb *>(binder_->getMacFromMacNodeId(cellId_))->getAmc();
         amc->attachUser(nodeId_, UL);
         amc->attachUser(nodeId_, DL);
 
@@ -375,6 +377,11 @@ void LteMacUe::handleSelfMessage()
         }
     }
 
+    // all the H-ARQ RX buffers are visited above: the pending and corrupted
+    // lists filled by the buffers (used by the eNB) are not needed
+    harqRxPending_.clear();
+    harqRxCorrupted_.clear();
+
     EV << NOW << "LteMacUe::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
     // updating current HARQ process for next TTI
 
@@ -773,102 +780,102 @@ void LteMacUe::deleteQueues(MacNodeId nodeId)
     connDesc_.clear();
 }
 
-void LteMacUe::collectCqiStatistics(MacNodeId id, Direction dir, LteFeedback fb)
+void LteMacUe::collectCqiStatistics(MacNodeId id, Direction dir, const LteFeedback& fb)
 {
     if (dir == DL)
     {
         if (fb.getTxMode() == SINGLE_ANTENNA_PORT0)
         {
-            for (unsigned int i = 0; i < fb.getBandCqi(0).size(); i++)
+            for (unsigned int i = 0; i < fb.getNumBands(); i++)
             {
                 switch (i)
                 {
                     case 0:
-                        emit(cqiDlSiso0_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSiso0_, (long)fb.getBandCqi(0, i));
                         break;
                     case 1:
-                        emit(cqiDlSiso1_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSiso1_, (long)fb.getBandCqi(0, i));
                         break;
                     case 2:
-                        emit(cqiDlSiso2_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSiso2_, (long)fb.getBandCqi(0, i));
                         break;
                     case 3:
-                        emit(cqiDlSiso3_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSiso3_, (long)fb.getBandCqi(0, i));
                         break;
                     case 4:
-                        emit(cqiDlSiso4_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSiso4_, (long)fb.getBandCqi(0, i));
                         break;
                 }
             }
         }
         else if (fb.getTxMode() == TRANSMIT_DIVERSITY)
         {
-            for (unsigned int i = 0; i < fb.getBandCqi(0).size(); i++)
+            for (unsigned int i = 0; i < fb.getNumBands(); i++)
             {
                 switch (i)
                 {
                     case 0:
-                        emit(cqiDlTxDiv0_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlTxDiv0_, (long)fb.getBandCqi(0, i));
                         break;
                     case 1:
-                        emit(cqiDlTxDiv1_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlTxDiv1_, (long)fb.getBandCqi(0, i));
                         break;
                     case 2:
-                        emit(cqiDlTxDiv2_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlTxDiv2_, (long)fb.getBandCqi(0, i));
                         break;
                     case 3:
-                        emit(cqiDlTxDiv3_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlTxDiv3_, (long)fb.getBandCqi(0, i));
                         break;
                     case 4:
-                        emit(cqiDlTxDiv4_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlTxDiv4_, (long)fb.getBandCqi(0, i));
                         break;
                 }
             }
         }
         else if (fb.getTxMode() == OL_SPATIAL_MULTIPLEXING)
         {
-            for (unsigned int i = 0; i < fb.getBandCqi(0).size(); i++)
+            for (unsigned int i = 0; i < fb.getNumBands(); i++)
             {
                 switch (i)
                 {
                     case 0:
-                        emit(cqiDlSpmux0_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSpmux0_, (long)fb.getBandCqi(0, i));
                         break;
                     case 1:
-                        emit(cqiDlSpmux1_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSpmux1_, (long)fb.getBandCqi(0, i));
                         break;
                     case 2:
-                        emit(cqiDlSpmux2_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSpmux2_, (long)fb.getBandCqi(0, i));
                         break;
                     case 3:
-                        emit(cqiDlSpmux3_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSpmux3_, (long)fb.getBandCqi(0, i));
                         break;
                     case 4:
-                        emit(cqiDlSpmux4_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlSpmux4_, (long)fb.getBandCqi(0, i));
                         break;
                 }
             }
         }
         else if (fb.getTxMode() == MULTI_USER)
         {
-            for (unsigned int i = 0; i < fb.getBandCqi(0).size(); i++)
+            for (unsigned int i = 0; i < fb.getNumBands(); i++)
             {
                 switch (i)
                 {
                     case 0:
-                        emit(cqiDlMuMimo0_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlMuMimo0_, (long)fb.getBandCqi(0, i));
                         break;
                     case 1:
-                        emit(cqiDlMuMimo1_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlMuMimo1_, (long)fb.getBandCqi(0, i));
                         break;
                     case 2:
-                        emit(cqiDlMuMimo2_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlMuMimo2_, (long)fb.getBandCqi(0, i));
                         break;
                     case 3:
-                        emit(cqiDlMuMimo3_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlMuMimo3_, (long)fb.getBandCqi(0, i));
                         break;
                     case 4:
-                        emit(cqiDlMuMimo4_, (long)fb.getBandCqi(0)[i]);
+                        emit(cqiDlMuMimo4_, (long)fb.getBandCqi(0, i));
                         break;
                 }
             }
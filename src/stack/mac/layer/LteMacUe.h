@@ -128,7 +128,7 @@ class LteMacUe : public LteMacBase
     /*
      * Record CQI-related statistics
      */
-    void collectCqiStatistics(MacNodeId id, Direction dir, LteFeedback fb);
+    void collectCqiStatistics(MacNodeId id, Direction dir, const LteFeedback& fb);
 
     /*
      * Access scheduling grant
@@ -42,9 +42,9 @@ void LteMacUeD2D::initialize(int stage)
     if (stage == inet::INITSTAGE_NETWORK_LAYER_3)
     {
         // get the reference to the eNB
-        enb_ = check_and_cast<LteMacEnbD2D*>(getSimulation()->getModule(binder_->getOmnetId(cellId_))->getSubmodule("lteNic")->getSubmodule("mac"));
+        enb_ = check_and_cast<LteMacEnbD2D*>(binder_->getMacFromMacNodeId(cellId_));
 
-        LteAmc *amc = check_and_cast<LteMacEnb *>(getSimulation()->getModule(binder_->getOmnetId(cellId_))->getSubmodule("lteNic")->getSubmodule("mac"))->getAmc();
+        LteAmc *amc = check_and_cast<LteMacEnb *>(binder_->getMacFromMacNodeId(cellId_))->getAmc();
         amc->attachUser(nodeId_, D2D);
 
         if (usePreconfiguredTxParams_)
@@ -154,6 +154,11 @@ void LteMacUeD2D::handleSelfMessage()
         enb_->storeRxHarqBufferMirror(nodeId_, mirbuff);
     }
 
+    // all the H-ARQ RX buffers are visited above: the pending and corrupted
+    // lists filled by the buffers (used by the eNB) are not needed
+    harqRxPending_.clear();
+    harqRxCorrupted_.clear();
+
     EV << NOW << "LteMacUeD2D::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
     // updating current HARQ process for next TTI
 
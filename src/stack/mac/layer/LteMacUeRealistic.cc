@@ -433,6 +433,11 @@ void LteMacUeRealistic::handleSelfMessage()
         }
     }
 
+    // all the H-ARQ RX buffers are visited above: the pending and corrupted
+    // lists filled by the buffers (used by the eNB) are not needed
+    harqRxPending_.clear();
+    harqRxCorrupted_.clear();
+
     EV << NOW << "LteMacUeRealistic::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
     // updating current HARQ process for next TTI
 
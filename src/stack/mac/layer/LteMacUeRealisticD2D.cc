@@ -52,9 +52,9 @@ void LteMacUeRealisticD2D::initialize(int stage)
         preconfiguredTxParams_ = getPreconfiguredTxParams();
 
         // get the reference to the eNB
-        enb_ = check_and_cast<LteMacEnbRealisticD2D*>(getSimulation()->getModule(binder_->getOmnetId(getMacCellId()))->getSubmodule("lteNic")->getSubmodule("mac"));
+        enb_ = check_and_cast<LteMacEnbRealisticD2D*>(binder_->getMacFromMacNodeId(getMacCellId()));
 
-        LteAmc *amc = check_and_cast<LteMacEnb *>(getSimulation()->getModule(binder_->getOmnetId(cellId_))->getSubmodule("lteNic")->getSubmodule("mac"))->getAmc();
+        LteAmc *amc = check_and_cast<LteMacEnb *>(binder_->getMacFromMacNodeId(cellId_))->getAmc();
         amc->attachUser(nodeId_, D2D);
     }
 }
@@ -597,6 +597,11 @@ void LteMacUeRealisticD2D::handleSelfMessage()
         enb_->storeRxHarqBufferMirror(nodeId_, mirbuff);
     }
 
+    // all the H-ARQ RX buffers are visited above: the pending and corrupted
+    // lists filled by the buffers (used by the eNB) are not needed
+    harqRxPending_.clear();
+    harqRxCorrupted_.clear();
+
     EV << NOW << "LteMacUeRealisticD2D::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
     // updating current HARQ process for next TTI
 
@@ -265,16 +265,17 @@ LcgSchedulerRealistic::schedule(unsigned int availableBytes, Direction grantDir)
                     while (alloc > 0)
                     {
                         // update pkt info
-                        PacketInfo newPktInfo = vQueue->popFront();
-                        if (newPktInfo.first > alloc)
+                        int vPktSize = vQueue->front().first;
+                        if (vPktSize > alloc)
                         {
-                            newPktInfo.first = newPktInfo.first - alloc;
-                            vQueue->pushFront(newPktInfo);
+                            // serve partial vPkt: shrink it in place
+                            vQueue->shrinkFront(alloc);
                             alloc = 0;
                         }
                         else
                         {
-                            alloc -= newPktInfo.first;
+                            vQueue->popFront();
+                            alloc -= vPktSize;
                         }
 
                     }
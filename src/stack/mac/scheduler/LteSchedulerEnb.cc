@@ -106,6 +106,9 @@ LteMacScheduleList* LteSchedulerEnb::schedule()
         EV << "____________________________ end SCHED ________________________________" << endl;
     }
 
+    // publish the bands occupied by this cell in the current round
+    allocator_->getOccupiedBands(binder_->updateBandOccupancy(mac_->getMacNodeId(), direction_));
+
     // record assigned resource blocks statistics
     resourceBlockStatistics();
     return &scheduleList_;
@@ -544,21 +547,9 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes,
                     // check if we are granting less than a full BSR |
                     if ((dir==UL || dir==D2D || dir==D2D_MULTI) && (toServe-MAC_HEADER-RLC_HEADER_UM<vQueueFrontSize))
                     {
-                        // update the virtual queue
-
-//                        conn->front().first = (vQueueFrontSize-toServe);
-
-                        // just decrementing the first element is not correct because the queueOccupancy would not be updated
-                        // we need to pop the element from the queue and then push it again with a new value
-                        unsigned int newSize = conn->front().first - (toServe-MAC_HEADER-RLC_HEADER_UM);
-                        PacketInfo info = conn->popFront();
-
-                        // push the element only if the size is > 0
-                        if (newSize > 0)
-                        {
-                            info.first = newSize;
-                            conn->pushFront(info);
-                        }
+                        // update the virtual queue: shrink the first element in place
+                        // (the queue occupancy is updated as well)
+                        conn->shrinkFront(toServe-MAC_HEADER-RLC_HEADER_UM);
                     }
                     else
                     {
@@ -764,12 +755,12 @@ unsigned int LteSchedulerEnb::availableBytes(const MacNodeId id,
     return bytes;
 }
 
-std::set<Band> LteSchedulerEnb::getOccupiedBands()
+void LteSchedulerEnb::getOccupiedBands(BandBitmap& occupiedBands)
 {
-   return allocator_->getAllocatorOccupiedBands();
+   allocator_->getOccupiedBands(occupiedBands);
 }
 
-void LteSchedulerEnb::storeAllocationEnb( std::vector<std::vector<AllocatedRbsPerBandMapA> > allocatedRbsPerBand,std::set<Band>* untouchableBands)
+void LteSchedulerEnb::storeAllocationEnb(const std::vector<std::vector<AllocatedRbsPerBandMapA> >& allocatedRbsPerBand, const BandBitmap* untouchableBands)
 {
     allocator_->storeAllocation(allocatedRbsPerBand, untouchableBands);
 }
@@ -300,9 +300,9 @@ class LteSchedulerEnb
     }
 
     // Get the bands already allocated
-    std::set<Band> getOccupiedBands();
+    void getOccupiedBands(BandBitmap& occupiedBands);
 
-    void storeAllocationEnb(std::vector<std::vector<AllocatedRbsPerBandMapA> > allocatedRbsPerBand, std::set<Band>* untouchableBands = NULL);
+    void storeAllocationEnb(const std::vector<std::vector<AllocatedRbsPerBandMapA> >& allocatedRbsPerBand, const BandBitmap* untouchableBands = NULL);
 
     // store an element in the schedule list
     void storeScListId(std::pair<unsigned int, Codeword> scList,unsigned int num_blocks);
@@ -279,10 +279,6 @@ LteSchedulerEnbDl::rtxschedule()
         }
         LteHarqBufferTx* currHarq = it->second;
 
-        // get harq status vector
-        BufferStatus harqStatus = currHarq->getBufferStatus();
-        BufferStatus::iterator jt = harqStatus.begin(), jet= harqStatus.end();
-
         // Get user transmission parameters
         const UserTxParams& txParams = mac_->getAmc()->computeTxParams(nodeId, direction_);// get the user info
         // TODO SK Get the number of codewords - FIX with correct mapping
@@ -290,29 +286,36 @@ LteSchedulerEnbDl::rtxschedule()
 
         EV << NOW << " LteSchedulerEnbDl::rtxschedule  UE: " << nodeId << endl;
         EV << NOW << " LteSchedulerEnbDl::rtxschedule Number of codewords: " << codewords << endl;
-        unsigned int process=0;
-        for(; jt != jet; ++jt,++process)
+
+        // snapshot of the units in rtx status: only processes having at least one of them are visited
+        const LteHarqStatusMask& harqStatus = currHarq->getStatusMask();
+        uint64_t rtxUnits[MAX_CODEWORDS];
+        uint64_t rtxProcesses = 0;
+        for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw)
+        {
+            rtxUnits[cw] = (cw < codewords) ? harqStatus.get(TXHARQ_PDU_BUFFERED, cw) : 0;
+            rtxProcesses |= rtxUnits[cw];
+        }
+
+        for(; rtxProcesses != 0; rtxProcesses &= rtxProcesses - 1)
         {
             // for each HARQ process
+            unsigned int process = lowestSetBit(rtxProcesses);
             if (allocatedCws_[nodeId] == codewords)
                 break;
-            for (Codeword cw = 0; cw < codewords; ++cw)
+            for (Codeword cw = 0; cw < codewords && cw < MAX_CODEWORDS; ++cw)
             {
                 if (allocatedCws_[nodeId]==codewords)
                 break;
                 EV << NOW << " LteSchedulerEnbDl::rtxschedule process " << process << endl;
                 EV << NOW << " LteSchedulerEnbDl::rtxschedule ------- CODEWORD " << cw << endl;
 
-                // skip processes which are not in rtx status
-                if (jt->at(cw).second != TXHARQ_PDU_BUFFERED)
-                {
-                    EV << NOW << " LteSchedulerEnbDl::rtxschedule detected Acid: " << jt->at(cw).first << " in status " << jt->at(cw).second << endl;
-
+                // skip units which are not in rtx status
+                if (!((rtxUnits[cw] >> process) & 1))
                     continue;
-                }
 
                 EV << NOW << " LteSchedulerEnbDl::rtxschedule " << endl;
-                EV << NOW << " LteSchedulerEnbDl::rtxschedule detected RTX Acid: " << jt->at(cw).first << endl;
+                EV << NOW << " LteSchedulerEnbDl::rtxschedule detected RTX Acid: " << process << endl;
 
                 // perform the retransmission
 
@@ -442,12 +442,8 @@ unsigned int LteSchedulerEnbDlRealistic::scheduleGrant(MacCid cid, unsigned int
             }
             else
             {
-                // serve partial vPkt
-
-                // update pkt info
-                PacketInfo newPktInfo = conn->popFront();
-                newPktInfo.first = newPktInfo.first - alloc;
-                conn->pushFront(newPktInfo);
+                // serve partial vPkt: shrink it in place
+                conn->shrinkFront(alloc);
                 alloc = 0;
             }
         }
@@ -27,11 +27,11 @@ LteSchedulerEnbUl::checkEligibility(MacNodeId id, Codeword& cw)
         // get current Harq Process for nodeId
         unsigned char currentAcid = harqStatus_.at(id);
         // get current Harq Process status
-        std::vector<RxUnitStatus> status = ulHarq->getProcess(currentAcid)->getProcessStatus();
+        const LteHarqStatusMask& status = ulHarq->getStatusMask();
         // check if at least one codeword buffer is available for reception
         for (; cw < MAX_CODEWORDS; ++cw)
         {
-            if (status.at(cw).second == RXHARQ_PDU_EMPTY)
+            if (status.test(currentAcid, cw, RXHARQ_PDU_EMPTY))
             {
                 return true;
             }
@@ -163,20 +163,9 @@ LteSchedulerEnbUl::rtxschedule()
             unsigned char currentAcid = harqStatus_.at(nodeId);
 
             // check whether the UE has a H-ARQ process waiting for retransmission. If not, skip UE.
-            bool skip = true;
             unsigned char acid = (currentAcid + 2) % (it->second->getProcesses());
-            LteHarqProcessRx* currentProcess = it->second->getProcess(acid);
-            std::vector<RxUnitStatus> procStatus = currentProcess->getProcessStatus();
-            std::vector<RxUnitStatus>::iterator pit = procStatus.begin();
-            for (; pit != procStatus.end(); ++pit )
-            {
-                if (pit->second == RXHARQ_PDU_CORRUPTED)
-                {
-                    skip = false;
-                    break;
-                }
-            }
-            if (skip)
+            uint64_t corrupted = it->second->getStatusMask().getAny(RXHARQ_PDU_CORRUPTED);
+            if (!((corrupted >> acid) & 1))
                 continue;
 
             EV << NOW << "LteSchedulerEnbUl::rtxschedule UE: " << nodeId << "Acid: " << (unsigned int)currentAcid << endl;
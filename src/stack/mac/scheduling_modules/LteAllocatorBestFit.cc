@@ -73,14 +73,17 @@ void LteAllocatorBestFit::prepareSchedule()
     initAndReset();
 
     // Get the bands occupied by RAC and RTX
-    std::set<Band> alreadyAllocatedBands = eNbScheduler_->getOccupiedBands();
-    unsigned int firstUnallocatedBand;
-    if(!alreadyAllocatedBands.empty())
+    eNbScheduler_->getOccupiedBands(alreadyAllocatedBands_);
+    unsigned int firstUnallocatedBand = 0;
+    // Get the latest occupied band
+    for (unsigned int b = alreadyAllocatedBands_.size(); b > 0; b--)
     {
-        // Get the last band in the Set (a set is ordered so the last band is the latest occupied)
-        firstUnallocatedBand = *alreadyAllocatedBands.rbegin();
+        if (alreadyAllocatedBands_[b - 1])
+        {
+            firstUnallocatedBand = b - 1;
+            break;
+        }
     }
-    else firstUnallocatedBand = 0;
 
     // Start the allocation of IM flows from the end of the frame
     int firstUnallocatedBandIM = eNbScheduler_->getResourceBlocks() - 1;
@@ -88,8 +91,8 @@ void LteAllocatorBestFit::prepareSchedule()
     // Get the active connection Set
     activeConnectionTempSet_ = activeConnectionSet_;
 
-    // Create a Conflict Map wich, for every nodeId, have a set of conflicting nodes
-    const std::map<MacNodeId,std::set<MacNodeId> >* conflictMap = mac_->getMeshMaster()->getConflictMap();
+    // Get the conflict graph, which tells for every couple of nodes whether they are conflicting
+    const MeshMaster* meshMaster = mac_->getMeshMaster();
 
     // record the amount of allocated bytes (for optimal comparison)
     unsigned int totalAllocatedBytes = 0;
@@ -289,7 +292,7 @@ void LteAllocatorBestFit::prepareSchedule()
             {
                 bool jump_band = false;
                 // Jump to the next band if this have been already allocated
-                if( alreadyAllocatedBands.find(band) != alreadyAllocatedBands.end() ) { jump_band = true; }
+                if( isAlreadyAllocated(band) ) { jump_band = true; }
                 /*
                  * Jump to the next band if:
                  * - dedicated is true
@@ -303,33 +306,16 @@ void LteAllocatorBestFit::prepareSchedule()
                  * Jump to the next band if the current band is occupied by a conflicting node (i.e. there's an edge in the
                  * conflict graph)
                  */
-                if( conflictMap->find(nodeId)!=conflictMap->end() )
-                {
-                    std::set<MacNodeId>::const_iterator conf_it = conflictMap->find(nodeId)->second.begin();
-                    std::set<MacNodeId>::const_iterator conf_et = conflictMap->find(nodeId)->second.end();
-                    for(;conf_it!=conf_et;++conf_it)
-                    {
-                        // Check if this band is occupied by an interfering node for the nodeId
-                        if(bandStatusMap_[band].second.find(*conf_it) != bandStatusMap_[band].second.end())
-                        {
-                            // Set jump_band to "true" cause we have to jump to the next band
-                            jump_band = true;
-                            break;
-                        }
-                    }
-                }
-
-                // Check if this band is occupied by a node for whom the nodeId is an interfering node
                 std::set<MacNodeId>::const_iterator it =  bandStatusMap_[band].second.begin();
                 for(;it!=bandStatusMap_[band].second.end();++it)
                 {
-                    if(conflictMap->find(*it)!=conflictMap->end())
+                    // Check if this band is occupied by an interfering node for the nodeId, or by a node
+                    // for whom the nodeId is an interfering node
+                    if(meshMaster->isConflicting(nodeId, *it) || meshMaster->isConflicting(*it, nodeId))
                     {
-                        if(conflictMap->find(*it)->second.find(nodeId)!=conflictMap->find(*it)->second.end())
-                        {
-                            jump_band = true;
-                            break;
-                        }
+                        // Set jump_band to "true" cause we have to jump to the next band
+                        jump_band = true;
+                        break;
                     }
                 }
 
@@ -370,7 +356,7 @@ void LteAllocatorBestFit::prepareSchedule()
             for( band=firstUnallocatedBandIM; band>=0; band-- )
             {
                 // Jump to the next band if this have been already allocated
-                if( alreadyAllocatedBands.find(band) != alreadyAllocatedBands.end() ) jump_band = true;
+                if( isAlreadyAllocated(band) ) jump_band = true;
                 /*
                  * Jump to the next band if the node is on Infrastructure and the band is already
                  * allocated to an Infrastructure node (As standard, the same bands are not shared
@@ -506,7 +492,7 @@ void LteAllocatorBestFit::prepareSchedule()
 
     }
 
-    eNbScheduler_->storeAllocationEnb(allocatedRbsPerBand_, &alreadyAllocatedBands);
+    eNbScheduler_->storeAllocationEnb(allocatedRbsPerBand_, &alreadyAllocatedBands_);
 
     // Reset direction to default direction if changed
     direction_ = (direction_ == D2D)? UL : direction_;
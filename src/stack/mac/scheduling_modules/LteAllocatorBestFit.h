@@ -50,6 +50,14 @@ class LteAllocatorBestFit : public virtual LteScheduler
     // Map that specify which bands can(non exclusive bands-D2D) or cannot(exlcusive bands-CELL) be shared
     std::map<Band,AllocationType_Set> bandStatusMap_;
 
+    // Bands already allocated (by RAC and RTX) when the allocation starts
+    BandBitmap alreadyAllocatedBands_;
+
+    bool isAlreadyAllocated(int band)
+    {
+        return band >= 0 && band < (int)alreadyAllocatedBands_.size() && alreadyAllocatedBands_[band];
+    }
+
     /**
      * Parameter that specify if the Allocator puts D2D and Infrastructure UEs on dedicated resources
      */
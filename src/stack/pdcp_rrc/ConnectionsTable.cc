@@ -1,97 +1,167 @@
-// 
+//
 //                           SimuLTE
-// 
+//
 // This file is part of a software released under the license included in file
 // "license.pdf". This license can be also found at http://www.ltesimulator.com/
-// The above file and the present reference are part of the software itself, 
+// The above file and the present reference are part of the software itself,
 // and cannot be removed from it.
-// 
+//
 
 #include "stack/pdcp_rrc/ConnectionsTable.h"
 
-ConnectionsTable::ConnectionsTable()
+ConnectionsTable::ConnectionsTable(unsigned int capacity)
 {
-    // Table is resetted by putting all fields equal to 0xFF
-    memset(ht_, 0xFF, sizeof(struct entry_) * TABLE_SIZE);
-}
+    unsigned int slots = 1;
+    while (slots < capacity)
+        slots <<= 1;
 
-unsigned int ConnectionsTable::hash_func(uint32_t srcAddr, uint32_t dstAddr,
-    uint16_t srcPort, uint16_t dstPort)
-{
-    return (srcPort | dstPort | srcAddr | dstAddr) % TABLE_SIZE;
+    entry_ empty;
+    empty.lcid_ = EMPTY_LCID;
+    ht_.assign(slots, empty);
+    mask_ = slots - 1;
+    size_ = 0;
+
+    lookups_ = 0;
+    probes_ = 0;
+    maxProbeLength_ = 0;
 }
 
 unsigned int ConnectionsTable::hash_func(uint32_t srcAddr, uint32_t dstAddr,
-    uint16_t srcPort, uint16_t dstPort, uint16_t dir)
+    uint16_t srcPort, uint16_t dstPort, uint16_t dir) const
 {
-    return (srcPort | dstPort | srcAddr | dstAddr | dir) % TABLE_SIZE;
+    uint64_t h = ((uint64_t)srcAddr << 32) | dstAddr;
+    h ^= (((uint64_t)srcPort << 32) | ((uint64_t)dstPort << 16) | dir) * 0x9E3779B97F4A7C15ULL;
+
+    // 64-bit finalizer (MurmurHash3)
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return (unsigned int)h & mask_;
 }
 
 LogicalCid ConnectionsTable::find_entry(uint32_t srcAddr, uint32_t dstAddr,
     uint16_t srcPort, uint16_t dstPort)
 {
-    int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort);
-    while (1)
-    {
-        if (ht_[hashIndex].lcid_ == 0xFFFF)            // Entry not found
-            return 0xFFFF;
-        if (ht_[hashIndex].srcAddr_ == srcAddr &&
-            ht_[hashIndex].dstAddr_ == dstAddr &&
-            ht_[hashIndex].srcPort_ == srcPort &&
-            ht_[hashIndex].dstPort_ == dstPort)
-            return ht_[hashIndex].lcid_;                // Entry found
-        hashIndex = (hashIndex + 1) % TABLE_SIZE;    // Linear scanning of the hash table
-    }
+    return find_entry(srcAddr, dstAddr, srcPort, dstPort, ANY_DIRECTION);
 }
 
 LogicalCid ConnectionsTable::find_entry(uint32_t srcAddr, uint32_t dstAddr,
     uint16_t srcPort, uint16_t dstPort, uint16_t dir)
 {
-    int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort, dir);
-    while (1)
+    unsigned int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort, dir);
+    unsigned int probeLength = 1;
+    LogicalCid lcid = EMPTY_LCID;
+    while (ht_[hashIndex].lcid_ != EMPTY_LCID)     // an empty slot ends the probe sequence
     {
-        if (ht_[hashIndex].lcid_ == 0xFFFF)            // Entry not found
-            return 0xFFFF;
-        if (ht_[hashIndex].srcAddr_ == srcAddr &&
-            ht_[hashIndex].dstAddr_ == dstAddr &&
-            ht_[hashIndex].srcPort_ == srcPort &&
-            ht_[hashIndex].dstPort_ == dstPort &&
-            ht_[hashIndex].dir_ == dir)
-            return ht_[hashIndex].lcid_;                // Entry found
-        hashIndex = (hashIndex + 1) % TABLE_SIZE;    // Linear scanning of the hash table
+        entry_& e = ht_[hashIndex];
+        if (e.srcAddr_ == srcAddr &&
+            e.dstAddr_ == dstAddr &&
+            e.srcPort_ == srcPort &&
+            e.dstPort_ == dstPort &&
+            e.dir_ == dir)
+        {
+            e.lastAccess_ = NOW;
+            lcid = e.lcid_;                             // Entry found
+            break;
+        }
+        hashIndex = (hashIndex + 1) & mask_;        // Linear scanning of the hash table
+        probeLength++;
     }
+
+    lookups_++;
+    probes_ += probeLength;
+    if (probeLength > maxProbeLength_)
+        maxProbeLength_ = probeLength;
+    return lcid;
 }
 
 void ConnectionsTable::create_entry(uint32_t srcAddr, uint32_t dstAddr,
     uint16_t srcPort, uint16_t dstPort, LogicalCid lcid)
 {
-    int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort);
-    while (ht_[hashIndex].lcid_ != 0xFFFF)
-        hashIndex = (hashIndex + 1) % TABLE_SIZE;    // Linear scanning of the hash table
-    ht_[hashIndex].srcAddr_ = srcAddr;
-    ht_[hashIndex].dstAddr_ = dstAddr;
-    ht_[hashIndex].srcPort_ = srcPort;
-    ht_[hashIndex].dstPort_ = dstPort;
-    ht_[hashIndex].lcid_ = lcid;
-    return;
+    create_entry(srcAddr, dstAddr, srcPort, dstPort, ANY_DIRECTION, lcid);
 }
 
 void ConnectionsTable::create_entry(uint32_t srcAddr, uint32_t dstAddr,
     uint16_t srcPort, uint16_t dstPort, uint16_t dir, LogicalCid lcid)
 {
-    int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort, dir);
-    while (ht_[hashIndex].lcid_ != 0xFFFF)
-        hashIndex = (hashIndex + 1) % TABLE_SIZE;    // Linear scanning of the hash table
+    // keep the load factor below 1/2, so that probe sequences stay short
+    if (2 * (size_ + 1) > mask_ + 1 && mask_ + 1 < TABLE_SIZE)
+        rehash(2 * (mask_ + 1));
+    // at least one slot must stay empty to terminate the probe sequences
+    if (size_ + 1 > mask_)
+        throw cRuntimeError("ConnectionsTable::create_entry - table full (%d connections)", size_);
+
+    unsigned int hashIndex = hash_func(srcAddr, dstAddr, srcPort, dstPort, dir);
+    while (ht_[hashIndex].lcid_ != EMPTY_LCID)
+        hashIndex = (hashIndex + 1) & mask_;        // Linear scanning of the hash table
     ht_[hashIndex].srcAddr_ = srcAddr;
     ht_[hashIndex].dstAddr_ = dstAddr;
     ht_[hashIndex].srcPort_ = srcPort;
     ht_[hashIndex].dstPort_ = dstPort;
     ht_[hashIndex].dir_ = dir;
     ht_[hashIndex].lcid_ = lcid;
+    ht_[hashIndex].lastAccess_ = NOW;
+    size_++;
     return;
 }
 
+unsigned int ConnectionsTable::evict_idle_entries(simtime_t threshold,
+    std::vector<LogicalCid>* evicted)
+{
+    unsigned int removed = 0;
+    for (unsigned int i = 0; i <= mask_; i++)
+    {
+        if (ht_[i].lcid_ != EMPTY_LCID && ht_[i].lastAccess_ < threshold)
+        {
+            if (evicted != NULL)
+                evicted->push_back(ht_[i].lcid_);
+            ht_[i].lcid_ = EMPTY_LCID;
+            removed++;
+        }
+    }
+
+    if (removed > 0)
+    {
+        // removing entries breaks the probe sequences of the remaining ones:
+        // reinsert them in a table of the same size
+        size_ -= removed;
+        rehash(mask_ + 1);
+    }
+    return removed;
+}
+
+void ConnectionsTable::rehash(unsigned int capacity)
+{
+    std::vector<entry_> old;
+    old.swap(ht_);
+
+    entry_ empty;
+    empty.lcid_ = EMPTY_LCID;
+    ht_.assign(capacity, empty);
+    mask_ = capacity - 1;
+
+    std::vector<entry_>::const_iterator it = old.begin();
+    for (; it != old.end(); ++it)
+    {
+        if (it->lcid_ == EMPTY_LCID)
+            continue;
+        unsigned int hashIndex = hash_func(it->srcAddr_, it->dstAddr_, it->srcPort_, it->dstPort_, it->dir_);
+        while (ht_[hashIndex].lcid_ != EMPTY_LCID)
+            hashIndex = (hashIndex + 1) & mask_;
+        ht_[hashIndex] = *it;
+    }
+}
+
+double ConnectionsTable::get_avg_probe_length() const
+{
+    if (lookups_ == 0)
+        return 0.0;
+    return (double)probes_ / lookups_;
+}
+
 ConnectionsTable::~ConnectionsTable()
 {
-    memset(ht_, 0xFF, sizeof(struct entry_) * TABLE_SIZE);
+    ht_.clear();
 }
@@ -10,9 +10,18 @@
 #ifndef _LTE_CONNECTIONSTABLE_H_
 #define _LTE_CONNECTIONSTABLE_H_
 
-/// This is the maximum number of allowed connections * 2
+/// Maximum number of slots of the table (must be a power of two)
 #define TABLE_SIZE 2048
 
+/// Initial number of slots of the table (must be a power of two)
+#define TABLE_INITIAL_SIZE 64
+
+/// LCID value marking an empty slot (also returned when a lookup fails)
+#define EMPTY_LCID 0xFFFF
+
+/// Direction value used for entries created through the 4-tuple interface
+#define ANY_DIRECTION 0xFFFF
+
 #include "common/LteCommon.h"
 
 /**
@@ -22,17 +31,26 @@
  * This is an hash table used by the RRC layer
  * to assign CIDs to different connections.
  * The table is in the format:
- *  __________________________________________________________
- * | srcAddr | dstAddr | srcPort | dstPort | Direction | LCID |
+ *  ___________________________________________________________________________
+ * | srcAddr | dstAddr | srcPort | dstPort | Direction | LCID | last access   |
  *
  * A 4-tuple (plus direction) is used to check if connection was already
  * established and return the proper LCID, otherwise a
- * new entry is added to the table
+ * new entry is added to the table.
+ *
+ * The table uses open addressing with linear probing over a power-of-two
+ * number of slots. Keys are spread with a 64-bit mixing function and the
+ * table doubles its size whenever the load factor exceeds 1/2, up to
+ * TABLE_SIZE slots. Entries that have not been accessed for a given
+ * time can be evicted with evict_idle_entries().
  */
 class ConnectionsTable
 {
   public:
-    ConnectionsTable();
+    /**
+     * @param capacity initial number of slots (rounded up to a power of two)
+     */
+    ConnectionsTable(unsigned int capacity = TABLE_INITIAL_SIZE);
     virtual ~ConnectionsTable();
 
     /**
@@ -91,33 +109,55 @@ class ConnectionsTable
     void create_entry(uint32_t srcAddr, uint32_t dstAddr,
         uint16_t srcPort, uint16_t dstPort, uint16_t dir, LogicalCid lcid);
 
+    /**
+     * evict_idle_entries() removes all the entries that have not been
+     * looked up or created since the given time
+     *
+     * @param threshold entries last accessed before this time are removed
+     * @param evicted if not NULL, the LCIDs of removed entries are appended here
+     * @return number of removed entries
+     */
+    unsigned int evict_idle_entries(simtime_t threshold,
+        std::vector<LogicalCid>* evicted = NULL);
+
+    /// Number of connections currently stored
+    unsigned int get_size() const { return size_; }
+
+    /// Number of slots currently allocated
+    unsigned int get_capacity() const { return mask_ + 1; }
+
+    /// Ratio between stored connections and allocated slots
+    double get_load_factor() const { return (double)size_ / (mask_ + 1); }
+
+    /// Average number of slots inspected per lookup
+    double get_avg_probe_length() const;
+
+    /// Maximum number of slots inspected by a single lookup
+    unsigned int get_max_probe_length() const { return maxProbeLength_; }
+
   private:
     /**
      * hash_func() calculates the hash function used
-     * by this structure. At the moment it's simply an OR
-     * operation between all fields of the 4-tuple
+     * by this structure. The 4-tuple plus direction is
+     * packed in two 64-bit words which are combined with
+     * a multiply-xorshift mixing function, so that all bits
+     * of the key affect the slot index
      *
      * @param srcAddr part of 4-tuple
      * @param dstAddr part of 4-tuple
      * @param srcPort part of 4-tuple
      * @param dstPort part of 4-tuple
+     * @param dir flow direction (DL/UL/D2D)
      */
     unsigned int hash_func(uint32_t srcAddr, uint32_t dstAddr,
-        uint16_t srcPort, uint16_t dstPort);
+        uint16_t srcPort, uint16_t dstPort, uint16_t dir) const;
 
     /**
-     * hash_func() calculates the hash function used
-     * by this structure. At the moment it's simply an OR
-     * operation between all fields of the 4-tuple
+     * rehash() moves all the entries to a new table of the given size
      *
-     * @param srcAddr part of 4-tuple
-     * @param dstAddr part of 4-tuple
-     * @param srcPort part of 4-tuple
-     * @param dir flow direction (DL/UL/D2D)
-     * @param dstPort part of 4-tuple
+     * @param capacity new number of slots (power of two)
      */
-    unsigned int hash_func(uint32_t srcAddr, uint32_t dstAddr,
-        uint16_t srcPort, uint16_t dstPort, uint16_t dir);
+    void rehash(unsigned int capacity);
 
     /*
      * Data Structures
@@ -129,8 +169,9 @@ class ConnectionsTable
      *
      * This structure contains an entry of the
      * connections hash table. It contains
-     * all fields of the 4-tuple and the
-     * associated LCID (Logical Connection ID).
+     * all fields of the 4-tuple, the direction,
+     * the associated LCID (Logical Connection ID)
+     * and the time of the last access.
      */
     struct entry_
     {
@@ -140,9 +181,19 @@ class ConnectionsTable
         uint16_t dstPort_;
         uint16_t dir_;
         LogicalCid lcid_;
+        simtime_t lastAccess_;
     };
-    /// Hash table of size TABLE_SIZE
-    entry_ ht_[TABLE_SIZE];
+    /// Hash table slots
+    std::vector<entry_> ht_;
+    /// Number of slots minus one
+    unsigned int mask_;
+    /// Number of used slots
+    unsigned int size_;
+
+    /// Lookup statistics
+    unsigned long lookups_;
+    unsigned long probes_;
+    unsigned int maxProbeLength_;
 };
 
 #endif
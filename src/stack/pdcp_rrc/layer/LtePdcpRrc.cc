@@ -107,6 +107,8 @@ void LtePdcpRrcBase::fromDataPort(cPacket *pkt)
     lteInfo->setDestId(getDestId(lteInfo));
     headerCompress(pkt, lteInfo->getHeaderSize()); // header compression
 
+    evictIdleConnections();
+
     // Cid Request
     EV << "LteRrc : Received CID request for Traffic [ " << "Source: "
        << IPv4Address(lteInfo->getSrcAddr()) << "@" << lteInfo->getSrcPort()
@@ -118,8 +120,18 @@ void LtePdcpRrcBase::fromDataPort(cPacket *pkt)
     if ((mylcid = ht_->find_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(),
         lteInfo->getSrcPort(), lteInfo->getDstPort())) == 0xFFFF)
     {
-        // LCID not found
-        mylcid = lcid_++;
+        // LCID not found: reuse the LCID of an evicted connection, if any
+        if (!freeLcids_.empty())
+        {
+            mylcid = freeLcids_.back();
+            freeLcids_.pop_back();
+        }
+        else
+        {
+            if (lcid_ == EMPTY_LCID)
+                throw cRuntimeError("LtePdcpRrcBase::fromDataPort - no more LCIDs available");
+            mylcid = lcid_++;
+        }
 
         EV << "LteRrc : Connection not found, new CID created with LCID " << mylcid << "\n";
 
@@ -216,6 +228,30 @@ void LtePdcpRrcBase::toEutranRrcSap(cPacket *pkt)
     send(upPkt, eutranRrcSap_[OUT]);
 }
 
+void LtePdcpRrcBase::evictIdleConnections()
+{
+    if (connectionIdleTimeout_ == 0 || NOW - lastIdleCheck_ < connectionIdleTimeout_)
+        return;
+    lastIdleCheck_ = NOW;
+
+    std::vector<LogicalCid> evicted;
+    ht_->evict_idle_entries(NOW - connectionIdleTimeout_, &evicted);
+
+    std::vector<LogicalCid>::iterator it = evicted.begin();
+    for (; it != evicted.end(); ++it)
+    {
+        PdcpEntities::iterator eit = entities_.find(*it);
+        if (eit != entities_.end())
+        {
+            delete eit->second;
+            entities_.erase(eit);
+        }
+        // the RLC and MAC entities of this LCID are kept and serve the next new connection
+        freeLcids_.push_back(*it);
+        EV << "LteRrc : Removed idle connection with LCID " << *it << "\n";
+    }
+}
+
 /*
  * Main functions
  */
@@ -237,6 +273,8 @@ void LtePdcpRrcBase::initialize(int stage)
 
         binder_ = getBinder();
         headerCompressedSize_ = par("headerCompressedSize"); // Compressed size
+        connectionIdleTimeout_ = par("connectionIdleTimeout");
+        lastIdleCheck_ = NOW;
         nodeId_ = getAncestorPar("macNodeId");
 
         // statistics
@@ -325,7 +363,11 @@ LtePdcpEntity* LtePdcpRrcBase::getEntity(LogicalCid lcid)
 
 void LtePdcpRrcBase::finish()
 {
-    // TODO make-finish
+    // connections table statistics
+    recordScalar("connectionsTableSize", ht_->get_size());
+    recordScalar("connectionsTableLoadFactor", ht_->get_load_factor());
+    recordScalar("connectionsTableAvgProbeLength", ht_->get_avg_probe_length());
+    recordScalar("connectionsTableMaxProbeLength", ht_->get_max_probe_length());
 }
 
 void LtePdcpRrcEnb::initialize(int stage)
@@ -198,6 +198,16 @@ class LtePdcpRrcBase : public cSimpleModule
      */
     void toEutranRrcSap(cPacket *pkt);
 
+    /**
+     * evictIdleConnections() removes from the connections table
+     * the flows that have been idle for more than connectionIdleTimeout,
+     * together with their PDCP entities. The LCIDs of removed flows
+     * are reused by new flows, so that the RLC and MAC entities created
+     * for them are not multiplied. The table is checked at most
+     * once per timeout interval
+     */
+    void evictIdleConnections();
+
     /*
      * Data structures
      */
@@ -211,9 +221,18 @@ class LtePdcpRrcBase : public cSimpleModule
     /// Connection Identifier
     LogicalCid lcid_;
 
+    /// LCIDs released by evicted connections, reused before allocating new ones
+    std::vector<LogicalCid> freeLcids_;
+
     /// Hash Table used for CID <-> Connection mapping
     ConnectionsTable* ht_;
 
+    /// Idle time after which a connection is removed from the table (0 = never)
+    simtime_t connectionIdleTimeout_;
+
+    /// Time of the last check for idle connections
+    simtime_t lastIdleCheck_;
+
     /// Identifier for this node
     MacNodeId nodeId_;
 
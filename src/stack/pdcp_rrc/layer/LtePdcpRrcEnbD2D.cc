@@ -58,6 +58,8 @@ void LtePdcpRrcEnbD2D::fromDataPort(cPacket *pkt)
        << " Destination: " << destAddr << "@" << lteInfo->getDstPort()
        << " , Direction: " << dirToA((Direction)lteInfo->getDirection()) << " ]\n";
 
+    evictIdleConnections();
+
     /*
      * Different lcid for different directions of the same flow are assigned.
      * RLC layer will create different RLC entities for different LCIDs
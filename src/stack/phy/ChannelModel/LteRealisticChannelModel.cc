@@ -818,9 +818,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
     if (dir == DL)
     {
         //get tx angle
-        LtePhyBase* ltePhy = check_and_cast<LtePhyBase*>(
-                getSimulation()->getModule(binder_->getOmnetId(eNbId))->getSubmodule(
-                        "lteNic")->getSubmodule("phy"));
+        LtePhyBase* ltePhy = binder_->getPhyFromMacNodeId(eNbId);
 
         if (ltePhy->getTxDirection() == ANISOTROPIC)
         {
@@ -2291,11 +2289,8 @@ double LteRealisticChannelModel::computeExtCellPathLoss(double dist, MacNodeId n
 LteRealisticChannelModel::JakesFadingMap * LteRealisticChannelModel::obtainUeJakesMap(MacNodeId id)
 {
     // obtain a reference to UE phy
-    LtePhyBase * ltePhy = check_and_cast<LtePhyBase*>(
-            getSimulation()->getModule(binder_->getOmnetId(id))->getSubmodule("lteNic")->getSubmodule("phy"));
-
     // get the associated channel and get a reference to its Jakes Map
-    LteRealisticChannelModel * re = dynamic_cast<LteRealisticChannelModel *>(ltePhy->getChannelModel());
+    LteRealisticChannelModel * re = dynamic_cast<LteRealisticChannelModel *>(binder_->getChannelModelFromMacNodeId(id));
     JakesFadingMap * j = re->getJakesMap();
 
     return j;
@@ -2331,7 +2326,7 @@ bool LteRealisticChannelModel::computeMultiCellInterference(MacNodeId eNbId, Mac
         if(!(*it)->init)
         {
             // obtain a reference to enb phy and obtain tx power
-            ltePhy = check_and_cast<LtePhyBase*>(getSimulation()->getModule(binder_->getOmnetId(id))->getSubmodule("lteNic")->getSubmodule("phy"));
+            ltePhy = binder_->getPhyFromMacNodeId(id);
             (*it)->txPwr = ltePhy->getTxPwr();//dBm
 
             // get tx direction
@@ -2377,29 +2372,16 @@ bool LteRealisticChannelModel::computeMultiCellInterference(MacNodeId eNbId, Mac
 
         txPwr = (*it)->txPwr - angolarAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
 
-        if(isCqi)// check slot occupation for this TTI
+        // check slot occupation for this TTI (CQI) or for the previous TTI (error computation).
+        // Bands are considered occupied if the cell has not published its occupancy yet
+        const BandBitmap* occupiedBands = binder_->getBandOccupancy(id, DL, !isCqi);
+        for(unsigned int i=0;i<band_;i++)
         {
-            for(unsigned int i=0;i<band_;i++)
-            {
-                // compute the number of occupied slot (unnecessary)
-                temp = (*it)->mac->getBandStatus(i);
-                if(temp!=0)
-                    (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
+            temp = (occupiedBands == NULL || i >= occupiedBands->size() || (*occupiedBands)[i]) ? 1 : 0;
+            if(temp!=0)
+                (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-                EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
-            }
-        }
-        else // error computation. We need to check the slot occupation of the previous TTI
-        {
-            for(unsigned int i=0;i<band_;i++)
-            {
-                // compute the number of occupied slot (unnecessary)
-                temp = (*it)->mac->getPrevBandStatus(i);
-                if(temp!=0)
-                    (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
-
-                EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
-            }
+            EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
         }
         ++it;
     }
@@ -2412,45 +2394,38 @@ bool LteRealisticChannelModel::computeInCellD2DInterference(MacNodeId eNbId, Mac
 {
     EV << "**** In Cell D2D Interference for cellId[" << eNbId << "] node["<<destId<<"] ****" << endl;
 
-    // Reference to the Physical Channel  of the UeId
-    LtePhyBase * ltePhy_destId;
     // Reference to the Physical Channel  of the Interfering UE
     LtePhyBase * ltePhy;
 
-    int temp;
     double att;
     double txPwr;
-    // Vector that report if a band must be excluded or not
-    std::vector<bool> band_status;
-    band_status.resize(band_,false);
 
-    // Get PhyData from the destId
-    ltePhy_destId = check_and_cast<LtePhyBase*>(getSimulation()->getModule(binder_->getOmnetId(destId))->getSubmodule("lteNic")->getSubmodule("phy"));
     EV<<NOW<<"ComputeInCellD2DInterference for Node: "<<destId<<endl;
 
-    // Get the list of all UEs
-    std::vector<UeInfo*> * ueList = binder_->getUeList();
-    std::vector<UeInfo*>::iterator it = ueList->begin(), et = ueList->end();
+    // Get the UEs that transmitted in the TTI of interest: the actual TTI
+    // for CQI computation, the previous one for error computation
+    const std::vector<UeTxInfo>& transmitters = binder_->getTransmitters(isCqi ? NOW : NOW - TTI);
+    std::vector<UeTxInfo>::const_iterator it = transmitters.begin(), et = transmitters.end();
 
-    // For all the UEs
+    // For all the UEs that transmitted
     for(;it!=et;it++)
     {
+        UeInfo* ueInfo = it->ue;
+
         //Get the id of the interfering node
-        MacNodeId interferringId = (*it)->id;
+        MacNodeId interferringId = ueInfo->id;
 
         // initialize UE data structures
-        if(!(*it)->init)
+        if(!ueInfo->init)
         {
             // get real Channel
-            (*it)->realChan = dynamic_cast<LteRealisticChannelModel *>((*it)->phy->getChannelModel());
+            ueInfo->realChan = dynamic_cast<LteRealisticChannelModel *>(ueInfo->phy->getChannelModel());
 
-            (*it)->init = true;
+            ueInfo->init = true;
         }
-        ltePhy = (*it)->phy;
+        ltePhy = ueInfo->phy;
 
-        if (isCqi && ltePhy->getLastActive() != NOW)  // if we are computing feedback and the interfering UE has not transmitted in this TTI, skip
-            continue;
-        if (!isCqi && ltePhy->getLastActive() != NOW - TTI)  // if we are decoding a transmission and the interfering UE has not transmitted in the previous TTI, skip
+        if (!isCqi && ltePhy->getLastActive() != NOW - TTI)  // if we are decoding a transmission and the interfering UE has transmitted again in this TTI, skip
             continue;
 
         // Skip Self-Interference and useful signal
@@ -2465,45 +2440,15 @@ bool LteRealisticChannelModel::computeInCellD2DInterference(MacNodeId eNbId, Mac
         txPwr = ltePhy->getTxPwr(dir) - cableLoss_ + 2 * antennaGainUe_;
         EV << "NodeId [" << interferringId << "] - attenuation [" << att << "]" << endl;
 
-        // The antenna set in computeTxParams is always "MACRO". Here create a fake set with MACRO as the only element
-        std::set<Remote> antennas;
-        antennas.insert(MACRO);
-        std::set<Remote>::const_iterator antenna_it = antennas.begin();
-        std::set<Remote>::const_iterator antenna_et = antennas.end();
-
-        // CQI computation. We need to check the slot occupation of the actual TTI
-        if(isCqi)
-        {
-            // For each band we have to check if the Band is occupied by the interferringId
-            for(unsigned int i=0;i<band_;i++)
-            {
-                for (antenna_it = antennas.begin(); antenna_it != antenna_et; ++antenna_it)
-                {
-                    temp = check_and_cast<LtePhyUe*>(ltePhy)->getUsedRbs(*antenna_it, i);
-                    // Compute interference only if the band is occupied by an Interfering Node
-                    if( temp!=0 )
-                    {
-                        // Add the interference
-                        (*interference)[i] += dBmToLinear(txPwr-att);
-                    }
-                }
-            }
-        }
-        else // Error computation. We need to check the slot occupation of the previous TTI
+        // For each band we have to check if the Band is occupied by the interferringId
+        // (the MACRO antenna is the only one used by UEs)
+        for(unsigned int i=0;i<band_ && i<it->usedBands.size();i++)
         {
-            // For each band we have to check if the Band in the previous TTI was occupied by the interferringId
-            for(unsigned int i=0;i<band_;i++)
+            // Compute interference only if the band is occupied by an Interfering Node
+            if (it->usedBands[i])
             {
-                for (antenna_it = antennas.begin(); antenna_it != antenna_et; ++antenna_it)
-                {
-                    temp = check_and_cast<LtePhyUe*>(ltePhy)->getPrevUsedRbs(*antenna_it, i);
-                    // Compute interference only if the band was occupied by an interfering Node
-                    if( temp!=0 )
-                    {
-                        // Add the interference
-                        (*interference)[i] += dBmToLinear(txPwr-att);
-                    }
-                }
+                // Add the interference
+                (*interference)[i] += dBmToLinear(txPwr-att);
             }
         }
     }
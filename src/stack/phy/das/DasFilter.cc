@@ -25,11 +25,9 @@ DasFilter::~DasFilter()
 
 void DasFilter::setMasterRuSet(MacNodeId masterId)
 {
-    cModule* module = getSimulation()->getModule(binder_->getOmnetId(masterId));
     if (getNodeTypeById(masterId) == ENODEB)
     {
-        das_ = check_and_cast<LtePhyEnb*>(module->getSubmodule("lteNic")->
-            getSubmodule("phy"))->getDasFilter();
+        das_ = check_and_cast<LtePhyEnb*>(binder_->getPhyFromMacNodeId(masterId))->getDasFilter();
         ruSet_ = das_->getRemoteAntennaSet();
     }
     else
@@ -266,7 +266,7 @@ void LteDlFeedbackGenerator::setTxMode(TxMode newTxMode)
     currentTxMode_ = newTxMode;
 }
 
-void LteDlFeedbackGenerator::sendFeedback(LteFeedbackDoubleVector fb,
+void LteDlFeedbackGenerator::sendFeedback(const LteFeedbackDoubleVector& fb,
     FbPeriodicity per)
 {
     EV << "sendFeedback() in DL" << endl;
@@ -79,7 +79,7 @@ class LteDlFeedbackGenerator : public cSimpleModule
     /**
      * DUMMY: should be provided by PHY
      */
-    void sendFeedback(LteFeedbackDoubleVector fb, FbPeriodicity per);
+    void sendFeedback(const LteFeedbackDoubleVector& fb, FbPeriodicity per);
 
     /**
      * Utility function used to create the feedback
@@ -8,10 +8,11 @@
 //
 
 #include <iostream>
+#include <stdexcept>
 #include "stack/phy/feedback/LteFeedback.h"
 
 void
-LteSummaryBuffer::createSummary(LteFeedback fb)
+LteSummaryBuffer::createSummary(const LteFeedback& fb)
 {
     try
     {
@@ -27,30 +28,30 @@ LteSummaryBuffer::createSummary(LteFeedback fb)
         // CQI
         if (fb.hasBandCqi()) // Per-band
         {
-            std::vector<CqiVector> cqi = fb.getBandCqi();
-            unsigned int n = cqi.size();
+            unsigned int n = fb.getBandCqiCodewords();
+            if (fb.getNumBands() < totBands_)
+                throw std::out_of_range("per-band CQI has fewer bands than the summary");
             for (Codeword cw = 0; cw < n; ++cw)
                 for (Band i = 0; i < totBands_; ++i)
-                    cumulativeSummary_.setCqi(cqi.at(cw).at(i), cw, i);
+                    cumulativeSummary_.setCqi(fb.getBandCqi(cw, i), cw, i);
         }
         else
         {
             if (fb.hasWbCqi()) // Wide-band
             {
-                CqiVector cqi(fb.getWbCqi());
-                unsigned int n = cqi.size();
+                unsigned int n = fb.getWbCqiCodewords();
                 for (Codeword cw = 0; cw < n; ++cw)
                     for (Band i = 0; i < totBands_; ++i)
-                        cumulativeSummary_.setCqi(cqi.at(cw), cw, i); // ripete lo stesso wb cqi su ogni banda della stessa cw
+                        cumulativeSummary_.setCqi(fb.getWbCqi(cw), cw, i); // ripete lo stesso wb cqi su ogni banda della stessa cw
             }
             if (fb.hasPreferredCqi()) // Preferred-band
             {
-                CqiVector cqi(fb.getPreferredCqi());
-                BandSet bands(fb.getPreferredBands());
+                const CqiVector& cqi = fb.getPreferredCqi();
+                const BandSet& bands = fb.getPreferredBands();
                 unsigned int n = cqi.size();
-                BandSet::iterator et = bands.end();
+                BandSet::const_iterator et = bands.end();
                 for (Codeword cw = 0; cw < n; ++cw)
-                    for (BandSet::iterator it = bands.begin(); it != et; ++it)
+                    for (BandSet::const_iterator it = bands.begin(); it != et; ++it)
                         cumulativeSummary_.setCqi(cqi.at(cw), cw, *it); // mette lo stesso cqi solo sulle bande preferite della stessa cw
             }
         }
@@ -60,7 +61,7 @@ LteSummaryBuffer::createSummary(LteFeedback fb)
         // PMI
         if (fb.hasBandPmi()) // Per-band
         {
-            PmiVector pmi(fb.getBandPmi());
+            const PmiVector& pmi = fb.getBandPmi();
             for (Band i = 0; i < totBands_; ++i)
                 cumulativeSummary_.setPmi(pmi.at(i), i);
         }
@@ -77,9 +78,9 @@ LteSummaryBuffer::createSummary(LteFeedback fb)
             {
                 // Preferred-band
                 Pmi pmi(fb.getPreferredPmi());
-                BandSet bands(fb.getPreferredBands());
-                BandSet::iterator et = bands.end();
-                for (BandSet::iterator it = bands.begin(); it != et; ++it)
+                const BandSet& bands = fb.getPreferredBands();
+                BandSet::const_iterator et = bands.end();
+                for (BandSet::const_iterator it = bands.begin(); it != et; ++it)
                     cumulativeSummary_.setPmi(pmi, *it);
             }
         }
@@ -19,7 +19,16 @@ class LteFeedback;
 typedef std::vector<LteFeedback> LteFeedbackVector;
 typedef std::vector<LteFeedbackVector> LteFeedbackDoubleVector;
 
-//! LTE feedback message exchanged between PHY and AMC.
+//! Maximum value of a CQI stored in a per-band report (4 bits)
+#define MAX_BAND_CQI 15
+
+/**
+ * LTE feedback message exchanged between PHY and AMC.
+ *
+ * Per-band CQIs are packed two per byte (4 bits each, codeword by codeword)
+ * and wide-band CQIs are stored in a fixed array, so that copying a report
+ * costs at most one allocation.
+ */
 class LteFeedback
 {
   protected:
@@ -40,12 +49,18 @@ class LteFeedback
     Rank rank_;
 
     //! Wide-band CQI, one per codeword.
-    CqiVector wideBandCqi_;
+    Cqi wideBandCqi_[MAX_CODEWORDS];
+    //! Number of codewords of the wide-band CQI.
+    unsigned char wbCodewords_;
     //! Wide-band PMI.
     Pmi wideBandPmi_;
 
-    //! Per-band CQI. (bandCqi_[cw][band])
-    std::vector<CqiVector> perBandCqi_;
+    //! Per-band CQI, 4 bits each. (CQI of [cw][band] is at position cw * numBands_ + band)
+    std::vector<unsigned char> perBandCqi_;
+    //! Number of codewords of the per-band CQI.
+    unsigned char bandCodewords_;
+    //! Number of bands of the per-band CQI.
+    unsigned short numBands_;
     //! Per-band PMI.
     PmiVector perBandPmi_;
 
@@ -66,11 +81,26 @@ class LteFeedback
     //! \test DAS SUPPORT - Antenna identifier
     Remote remoteAntennaId_;
 
+    //! Store the per-band CQI of a band (the position must be allocated).
+    void setBandCqiNibble(unsigned int pos, Cqi cqi)
+    {
+        if (cqi > MAX_BAND_CQI)
+            throw cRuntimeError("LteFeedback: per-band CQI %d cannot be stored in 4 bits", cqi);
+        unsigned char& byte = perBandCqi_[pos / 2];
+        if (pos % 2)
+            byte = (byte & 0x0F) | (cqi << 4);
+        else
+            byte = (byte & 0xF0) | cqi;
+    }
+
   public:
 
     //! Create an empty feedback message.
     LteFeedback()
     {
+        wbCodewords_ = 0;
+        bandCodewords_ = 0;
+        numBands_ = 0;
         status_ = EMPTY;
         txMode_ = SINGLE_ANTENNA_PORT0;
         periodicFeedback_ = true;
@@ -80,8 +110,10 @@ class LteFeedback
     //! Reset this feedback message as empty.
     void reset()
     {
-        wideBandCqi_.clear();
+        wbCodewords_ = 0;
         perBandCqi_.clear();
+        bandCodewords_ = 0;
+        numBands_ = 0;
         preferredCqi_.clear();
         preferredBands_.clear();
 
@@ -141,13 +173,18 @@ class LteFeedback
     //! Get the wide-band CQI. Does not check if valid.
     CqiVector getWbCqi() const
     {
-        return wideBandCqi_;
+        return CqiVector(wideBandCqi_, wideBandCqi_ + wbCodewords_);
     }
     //! Get the wide-band CQI for one codeword. Does not check if valid.
     Cqi getWbCqi(Codeword cw) const
     {
         return wideBandCqi_[cw];
     }
+    //! Get the number of codewords of the wide-band CQI.
+    unsigned int getWbCqiCodewords() const
+    {
+        return wbCodewords_;
+    }
     //! Get the wide-band PMI. Does not check if valid.
     Pmi getWbPmi() const
     {
@@ -156,20 +193,42 @@ class LteFeedback
     //! Get the per-band CQI. Does not check if valid.
     std::vector<CqiVector> getBandCqi() const
     {
-        return perBandCqi_;
+        std::vector<CqiVector> cqi;
+        for (Codeword cw = 0; cw < bandCodewords_; ++cw)
+            cqi.push_back(getBandCqi(cw));
+        return cqi;
     }
     //! Get the per-band CQI for one codeword. Does not check if valid.
     CqiVector getBandCqi(Codeword cw) const
     {
-        return perBandCqi_[cw];
+        CqiVector cqi(numBands_);
+        for (Band b = 0; b < numBands_; ++b)
+            cqi[b] = getBandCqi(cw, b);
+        return cqi;
+    }
+    //! Get the per-band CQI for one codeword and one band. Does not check if valid.
+    Cqi getBandCqi(Codeword cw, Band band) const
+    {
+        unsigned int pos = cw * numBands_ + band;
+        return (perBandCqi_[pos / 2] >> ((pos % 2) * 4)) & 0x0F;
+    }
+    //! Get the number of codewords of the per-band CQI.
+    unsigned int getBandCqiCodewords() const
+    {
+        return bandCodewords_;
+    }
+    //! Get the number of bands of the per-band CQI.
+    unsigned int getNumBands() const
+    {
+        return numBands_;
     }
     //! Get the per-band PMI. Does not check if valid.
-    PmiVector getBandPmi() const
+    const PmiVector& getBandPmi() const
     {
         return perBandPmi_;
     }
     //! Get the per preferred band CQI. Does not check if valid.
-    CqiVector getPreferredCqi() const
+    const CqiVector& getPreferredCqi() const
     {
         return preferredCqi_;
     }
@@ -184,7 +243,7 @@ class LteFeedback
         return preferredPmi_;
     }
     //! Get the set of preferred bands. Does not check if valid.
-    BandSet getPreferredBands() const
+    const BandSet& getPreferredBands() const
     {
         return preferredBands_;
     }
@@ -208,18 +267,23 @@ class LteFeedback
         status_ |= RANK_INDICATION;
     }
     //! Set the wide-band CQI.
-    void setWideBandCqi(const CqiVector wbCqi)
+    void setWideBandCqi(const CqiVector& wbCqi)
     {
-        wideBandCqi_ = wbCqi;
+        if (wbCqi.size() > MAX_CODEWORDS)
+            throw cRuntimeError("LteFeedback::setWideBandCqi(): %d codewords, at most %d are supported", (int)wbCqi.size(), MAX_CODEWORDS);
+        wbCodewords_ = wbCqi.size();
+        for (Codeword cw = 0; cw < wbCodewords_; ++cw)
+            wideBandCqi_[cw] = wbCqi[cw];
         status_ |= WB_CQI;
     }
     //! Set the wide-band CQI for one codeword. Does not check if valid.
     void setWideBandCqi(const Cqi cqi, const Codeword cw)
     {
-        if (wideBandCqi_.size() == cw)
-            wideBandCqi_.push_back(cqi);
-        else
-            wideBandCqi_[cw] = cqi;
+        if (cw >= MAX_CODEWORDS)
+            throw cRuntimeError("LteFeedback::setWideBandCqi(): codeword %d, at most %d are supported", cw, MAX_CODEWORDS);
+        if (wbCodewords_ <= cw)
+            wbCodewords_ = cw + 1;
+        wideBandCqi_[cw] = cqi;
 
         status_ |= WB_CQI;
     }
@@ -230,30 +294,41 @@ class LteFeedback
         status_ |= WB_PMI;
     }
     //! Set the per-band CQI.
-    void setPerBandCqi(const std::vector<CqiVector> bandCqi)
+    void setPerBandCqi(const std::vector<CqiVector>& bandCqi)
     {
-        perBandCqi_ = bandCqi;
+        perBandCqi_.clear();
+        bandCodewords_ = 0;
+        for (Codeword cw = 0; cw < bandCqi.size(); ++cw)
+            setPerBandCqi(bandCqi[cw], cw);
         status_ |= BAND_CQI;
     }
-    //! Set the per-band CQI for one codeword. Does not check if valid.
-    void setPerBandCqi(const CqiVector bandCqi, const Codeword cw)
+    //! Set the per-band CQI for one codeword. All the codewords must have the same number of bands.
+    void setPerBandCqi(const CqiVector& bandCqi, const Codeword cw)
     {
-        if (perBandCqi_.size() == cw)
-            perBandCqi_.push_back(bandCqi);
-        else
-            perBandCqi_[cw] = bandCqi;
+        if (bandCodewords_ == 0)
+            numBands_ = bandCqi.size();
+        else if (bandCqi.size() != numBands_)
+            throw cRuntimeError("LteFeedback::setPerBandCqi(): %d bands for codeword %d, %d expected", (int)bandCqi.size(), cw, numBands_);
+
+        if (bandCodewords_ <= cw)
+        {
+            bandCodewords_ = cw + 1;
+            perBandCqi_.resize((bandCodewords_ * numBands_ + 1) / 2, 0);
+        }
+        for (Band b = 0; b < numBands_; ++b)
+            setBandCqiNibble(cw * numBands_ + b, bandCqi[b]);
 
         status_ |= BAND_CQI;
     }
     //! Set the per-band PMI.
-    void setPerBandPmi(const PmiVector bandPmi)
+    void setPerBandPmi(const PmiVector& bandPmi)
     {
         perBandPmi_ = bandPmi;
         status_ |= BAND_PMI;
     }
 
     //! Set the per preferred band CQI.
-    void setPreferredCqi(const CqiVector preferredCqi)
+    void setPreferredCqi(const CqiVector& preferredCqi)
     {
         preferredCqi_ = preferredCqi;
         status_ |= PREFERRED_CQI;
@@ -275,7 +350,7 @@ class LteFeedback
         status_ |= PREFERRED_PMI;
     }
     //! Set the per preferred bands. Invoke this function everytime you invoke setPreferredCqi().
-    void setPreferredBands(const BandSet preferredBands)
+    void setPreferredBands(const BandSet& preferredBands)
     {
         preferredBands_ = preferredBands;
     }
@@ -327,7 +402,7 @@ class LteFeedback
 
         if(hasPreferredCqi())
         {
-            CqiVector cqi = getPreferredCqi();
+            const CqiVector& cqi = getPreferredCqi();
             unsigned int codewords = cqi.size();
             for(Codeword cw = 0; cw < codewords; ++cw)
             EV << NOW << " " << s << " Preferred CQI[" << cw << "] = " << cqi.at(cw) << "\n";
@@ -335,25 +410,23 @@ class LteFeedback
 
         if(hasWbCqi())
         {
-            CqiVector cqi = getWbCqi();
-            unsigned int codewords = cqi.size();
+            unsigned int codewords = getWbCqiCodewords();
             for(Codeword cw = 0; cw < codewords; ++cw)
-            EV << NOW << " " << s << " Wideband CQI[" << cw << "] = " << cqi.at(cw) << "\n";
+            EV << NOW << " " << s << " Wideband CQI[" << cw << "] = " << getWbCqi(cw) << "\n";
         }
 
         if(hasBandCqi())
         {
-            std::vector<CqiVector> cqi = getBandCqi();
-            unsigned int codewords = cqi.size();
+            unsigned int codewords = getBandCqiCodewords();
             for(Codeword cw = 0; cw < codewords; ++cw)
             {
                 EV << NOW << " " << s << " Band CQI[" << cw << "] = {";
-                unsigned int bands = cqi[0].size();
+                unsigned int bands = getNumBands();
                 if(bands > 0)
                 {
-                    EV << cqi.at(cw).at(0);
+                    EV << getBandCqi(cw, 0);
                     for(Band b = 1; b < bands; ++b)
-                    EV << ", " << cqi.at(cw).at(b);
+                    EV << ", " << getBandCqi(cw, b);
                 }
                 EV << "}\n";
             }
@@ -373,7 +446,7 @@ class LteFeedback
 
         if(hasBandCqi())
         {
-            PmiVector pmi = getBandPmi();
+            const PmiVector& pmi = getBandPmi();
             EV << NOW << " " << s << " Band PMI = {";
             unsigned int bands = pmi.size();
             if(bands > 0)
@@ -387,9 +460,9 @@ class LteFeedback
 
         if(hasPreferredCqi() || hasPreferredPmi())
         {
-            BandSet band = getPreferredBands();
-            BandSet::iterator it = band.begin();
-            BandSet::iterator et = band.end();
+            const BandSet& band = getPreferredBands();
+            BandSet::const_iterator it = band.begin();
+            BandSet::const_iterator et = band.end();
             EV << NOW << " " << s << " Preferred Bands = {";
             if(it != et)
             {
@@ -567,7 +640,7 @@ class LteSummaryFeedback
         return confidence(tPmi_.at(band));
     }
 
-    bool isValid()
+    bool isValid() const
     {
         return valid_;
     }
@@ -639,20 +712,26 @@ class LteSummaryFeedback
     }
 };
 
+/**
+ * @class LteSummaryBuffer
+ *
+ * Feedback summary of one (remote, UE, txmode) triple.
+ *
+ * Each report updates the cumulative summary in place, so no history of
+ * past reports is kept and memory does not depend on the buffer dimension.
+ */
 class LteSummaryBuffer
 {
   protected:
     //! Buffer dimension
     unsigned char bufferSize_;
-    //! The buffer
-    std::list<LteFeedback> buffer_;
     //! Number of codewords.
     double totCodewords_;
     //! Number of bands.
     double totBands_;
     //! Cumulative summary feedback.
     LteSummaryFeedback cumulativeSummary_;
-    void createSummary(LteFeedback fb);
+    void createSummary(const LteFeedback& fb);
 
   public:
 
@@ -665,21 +744,13 @@ class LteSummaryBuffer
     }
 
     //! Put a feedback into the buffer and update current summary feedback
-    void put(LteFeedback fb)
+    void put(const LteFeedback& fb)
     {
-        if (bufferSize_ > 0)
-        {
-            buffer_.push_back(fb);
-        }
-        if (buffer_.size() > bufferSize_)
-        {
-            buffer_.pop_front();
-        }
         createSummary(fb);
     }
 
     //! Get the current summary feedback
-    LteSummaryFeedback get() const
+    const LteSummaryFeedback& get() const
     {
         return cumulativeSummary_;
     }
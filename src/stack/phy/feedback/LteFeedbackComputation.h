@@ -29,8 +29,8 @@ class LteFeedbackComputation
      */
     virtual LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
         TxMode currentTxMode,
-        std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
-        int numRus, std::vector<double> snr, MacNodeId id = 0)=0;
+        const std::map<Remote, int>& antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
+        int numRus, const std::vector<double>& snr, MacNodeId id = 0)=0;
     /**
      * Interface for Feedback computation
      *
@@ -45,7 +45,7 @@ class LteFeedbackComputation
     virtual LteFeedbackVector computeFeedback(const Remote remote, FeedbackType fbType,
         RbAllocationType rbAllocationType, TxMode currentTxMode,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0)=0;
+        const std::vector<double>& snr, MacNodeId id = 0)=0;
     /**
      * Interface for Feedback computation
      *
@@ -61,7 +61,15 @@ class LteFeedbackComputation
     virtual LteFeedback computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
         RbAllocationType rbAllocationType,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0)=0;
+        const std::vector<double>& snr, MacNodeId id = 0)=0;
+
+  protected:
+    /// Number of codewords of the given remote, 0 if it has none configured
+    static int getAntennaCws(const std::map<Remote, int>& antennaCws, Remote remote)
+    {
+        std::map<Remote, int>::const_iterator it = antennaCws.find(remote);
+        return (it == antennaCws.end()) ? 0 : it->second;
+    }
 };
 
 #endif
@@ -34,8 +34,8 @@ LteFeedbackComputationDummy::~LteFeedbackComputationDummy()
 
 LteFeedbackDoubleVector LteFeedbackComputationDummy::computeFeedback(FeedbackType fbType,
     RbAllocationType rbAllocationType,
-    TxMode currentTxMode, std::map<Remote, int> antennaCws, int numPreferredBands,
-    FeedbackGeneratorType feedbackGeneratortype, int numRus, std::vector<double> snr, MacNodeId id)
+    TxMode currentTxMode, const std::map<Remote, int>& antennaCws, int numPreferredBands,
+    FeedbackGeneratorType feedbackGeneratortype, int numRus, const std::vector<double>& snr, MacNodeId id)
 {
     //add enodeB to the number of antenna
     numRus++;
@@ -76,7 +76,7 @@ LteFeedbackDoubleVector LteFeedbackComputationDummy::computeFeedback(FeedbackTyp
             fb.setWideBandPmi(intuniform(getEnvir()->getRNG(0), 1, pow(lastRank_, (double) 2)));
 
             //generate feedback for txmode z
-            generateBaseFeedback(numBands_, numPreferredBands, fb, fbType, antennaCws[(Remote) j], rbAllocationType,
+            generateBaseFeedback(numBands_, numPreferredBands, fb, fbType, getAntennaCws(antennaCws, (Remote) j), rbAllocationType,
                 (TxMode) z);
             // add the feedback to the feedback structure
             fbvv[j][z] = fb;
@@ -88,7 +88,7 @@ LteFeedbackDoubleVector LteFeedbackComputationDummy::computeFeedback(FeedbackTyp
 LteFeedbackVector LteFeedbackComputationDummy::computeFeedback(const Remote remote, FeedbackType fbType,
     RbAllocationType rbAllocationType,
     TxMode currentTxMode, int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
-    int numRus, std::vector<double> snr, MacNodeId id)
+    int numRus, const std::vector<double>& snr, MacNodeId id)
 {
     // New Feedback
     LteFeedbackVector fbv;
@@ -133,7 +133,7 @@ LteFeedbackVector LteFeedbackComputationDummy::computeFeedback(const Remote remo
 LteFeedback LteFeedbackComputationDummy::computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
     RbAllocationType rbAllocationType,
     int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-    std::vector<double> snr, MacNodeId id)
+    const std::vector<double>& snr, MacNodeId id)
 {
     // New Feedback
     LteFeedback fb;
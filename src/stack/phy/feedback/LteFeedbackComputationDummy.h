@@ -56,8 +56,8 @@ class LteFeedbackComputationDummy : public LteFeedbackComputation
      */
     virtual LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
         TxMode currentTxMode,
-        std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
-        int numRus, std::vector<double> snr, MacNodeId id = 0);
+        const std::map<Remote, int>& antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
+        int numRus, const std::vector<double>& snr, MacNodeId id = 0);
     /**
      * Performs Random Feedback computation using Pagano's rules
      *
@@ -67,7 +67,7 @@ class LteFeedbackComputationDummy : public LteFeedbackComputation
     virtual LteFeedbackVector computeFeedback(const Remote remote, FeedbackType fbType,
         RbAllocationType rbAllocationType, TxMode currentTxMode,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0);
+        const std::vector<double>& snr, MacNodeId id = 0);
     /**
      * Performs Random Feedback computation using Pagano's rules
      *
@@ -78,7 +78,7 @@ class LteFeedbackComputationDummy : public LteFeedbackComputation
     virtual LteFeedback computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
         RbAllocationType rbAllocationType,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0);
+        const std::vector<double>& snr, MacNodeId id = 0);
 };
 
 #endif
@@ -22,6 +22,7 @@ LteFeedbackComputationRealistic::LteFeedbackComputationRealistic(double targetBl
     lambdaMaxTh_ = lambdaMaxTh;
     lambdaRatioTh_ = lambdaRatioTh;
     phyPisaData_ = &(getBinder()->phyPisaData);
+    buildCqiTable();
 }
 
 LteFeedbackComputationRealistic::~LteFeedbackComputationRealistic()
@@ -30,7 +31,7 @@ LteFeedbackComputationRealistic::~LteFeedbackComputationRealistic()
 }
 
 void LteFeedbackComputationRealistic::generateBaseFeedback(int numBands, int numPreferredBands, LteFeedback& fb,
-    FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr)
+    FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr)
 {
     int layer = 1;
     std::vector<CqiVector> cqiTmp2;
@@ -60,17 +61,12 @@ void LteFeedbackComputationRealistic::generateBaseFeedback(int numBands, int num
     {
         if (rbAllocationType == TYPE2_LOCALIZED)
         {
-            cqiTmp2.resize(layer);
-            for (unsigned int i = 0; i < cqiTmp2.size(); i++)
-            {
-                cqiTmp2[i].resize(numBands, 0);
-                for (int j = 0; j < numBands; j++)
-                {
-                    cqi = getCqi(txmode, snr[j]);
-                    cqiTmp2[i][j] = cqi;
-                }
-                fb.setPerBandCqi(cqiTmp2[i], i);
-            }
+            // per-band cqi does not depend on the layer: compute it once
+            cqiTmp.resize(numBands, 0);
+            for (int j = 0; j < numBands; j++)
+                cqiTmp[j] = getCqi(txmode, snr[j]);
+            for (int i = 0; i < layer; i++)
+                fb.setPerBandCqi(cqiTmp, i);
         }
         else if (rbAllocationType == TYPE2_DISTRIBUTED)
         {
@@ -101,36 +97,48 @@ unsigned int LteFeedbackComputationRealistic::computeRank(MacNodeId id)
         return 2;
 }
 
+void LteFeedbackComputationRealistic::buildCqiTable()
+{
+    // for each txmode and rounded snr, the cqi is the one whose BLER curve
+    // is closest to the target BLER
+    cqiTableSnrs_ = phyPisaData_->maxSnr() + 1;
+    cqiTable_.resize(phyPisaData_->nTxMode() * cqiTableSnrs_);
+    for (int txm = 0; txm < phyPisaData_->nTxMode(); txm++)
+    {
+        for (int newsnr = 0; newsnr < cqiTableSnrs_; newsnr++)
+        {
+            int found = 0;
+            double low = 2;
+            for (int i = 0; i < phyPisaData_->nMcs(); i++)
+            {
+                double tmp = phyPisaData_->getBler(txm, i, newsnr);
+                double diff = targetBler_ - tmp;
+                double min = (diff > 0) ? diff : (diff * -1);
+                if (low >= min)
+                {
+                    found = i;
+                    low = min;
+                }
+            }
+            cqiTable_[txm * cqiTableSnrs_ + newsnr] = found + 1;
+        }
+    }
+}
+
 Cqi LteFeedbackComputationRealistic::getCqi(TxMode txmode, double snr)
 {
     int newsnr = floor(snr + 0.5);
     if (newsnr < 0)
         return 0;
-    if (newsnr > phyPisaData_->maxSnr())
+    if (newsnr >= cqiTableSnrs_)
         return 15;
-    unsigned int txm = txModeToIndex[txmode];
-    std::vector<double> min;
-    int found = 0;
-    double low = 2;
-    min.resize(phyPisaData_->nMcs(), 2);
-    for (int i = 0; i < phyPisaData_->nMcs(); i++)
-    {
-        double tmp = phyPisaData_->getBler(txm, i, newsnr);
-        double diff = targetBler_ - tmp;
-        min[i] = (diff > 0) ? diff : (diff * -1);
-        if (low >= min[i])
-        {
-            found = i;
-            low = min[i];
-        }
-    }
-    return found + 1;
+    return cqiTable_[txModeToIndex[txmode] * cqiTableSnrs_ + newsnr];
 }
 
 LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(FeedbackType fbType,
     RbAllocationType rbAllocationType, TxMode currentTxMode,
-    std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-    std::vector<double> snr, MacNodeId id)
+    const std::map<Remote, int>& antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
+    const std::vector<double>& snr, MacNodeId id)
 {
     //add enodeB to the number of antenna
     numRus++;
@@ -162,7 +170,7 @@ LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(Feedbac
                 //set the pmi
                 fb.setWideBandPmi(intuniform(getEnvir()->getRNG(0), 1, pow(rank, (double) 2)));
                 //generate feedback for txmode z
-                generateBaseFeedback(numBands_, numPreferredBands, fb, fbType, antennaCws[(Remote) j], rbAllocationType,
+                generateBaseFeedback(numBands_, numPreferredBands, fb, fbType, getAntennaCws(antennaCws, (Remote) j), rbAllocationType,
                     (TxMode) z, snr);
             }
             // add the feedback to the feedback structure
@@ -181,7 +189,7 @@ LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(Feedbac
 LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote remote, FeedbackType fbType,
     RbAllocationType rbAllocationType, TxMode currentTxMode,
     int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-    std::vector<double> snr, MacNodeId id)
+    const std::vector<double>& snr, MacNodeId id)
 {
     // New Feedback
     LteFeedbackVector fbv;
@@ -223,7 +231,7 @@ LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote
 LteFeedback LteFeedbackComputationRealistic::computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
     RbAllocationType rbAllocationType,
     int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-    std::vector<double> snr, MacNodeId id)
+    const std::vector<double>& snr, MacNodeId id)
 {
     // New Feedback
     LteFeedback fb;
@@ -253,10 +261,10 @@ LteFeedback LteFeedbackComputationRealistic::computeFeedback(const Remote remote
     return fb;
 }
 
-double LteFeedbackComputationRealistic::meanSnr(std::vector<double> snr)
+double LteFeedbackComputationRealistic::meanSnr(const std::vector<double>& snr)
 {
     double mean = 0;
-    std::vector<double>::iterator it;
+    std::vector<double>::const_iterator it;
     for (it = snr.begin(); it != snr.end(); ++it)
         mean += *it;
     mean /= snr.size();
@@ -27,16 +27,22 @@ class LteFeedbackComputationRealistic : public LteFeedbackComputation
     double lambdaRatioTh_;
     //pointer to pisadata
     PhyPisaData* phyPisaData_;
+    //Cqi for each (txmode index, rounded snr), computed from BLER curves for targetBler_
+    std::vector<Cqi> cqiTable_;
+    //Number of snr entries per txmode in cqiTable_
+    int cqiTableSnrs_;
 
   protected:
     // Rank computation
     unsigned int computeRank(MacNodeId id);
     // Generate base feedback for all types of feedback(allbands, preferred, wideband)
     void generateBaseFeedback(int numBands, int numPreferredBabds, LteFeedback& fb, FeedbackType fbType, int cw,
-        RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr);
-    // Get cqi from BLer Curves
+        RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr);
+    // Fill cqiTable_ by scanning BLer Curves
+    void buildCqiTable();
+    // Get cqi from BLer Curves (looked up in cqiTable_)
     Cqi getCqi(TxMode txmode, double snr);
-    double meanSnr(std::vector<double> snr);
+    double meanSnr(const std::vector<double>& snr);
     public:
     LteFeedbackComputationRealistic(double targetBler, std::map<MacNodeId, Lambda>* lambda, double lambdaMinTh,
         double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands);
@@ -44,18 +50,18 @@ class LteFeedbackComputationRealistic : public LteFeedbackComputation
 
     virtual LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
         TxMode currentTxMode,
-        std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
-        int numRus, std::vector<double> snr, MacNodeId id = 0);
+        const std::map<Remote, int>& antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
+        int numRus, const std::vector<double>& snr, MacNodeId id = 0);
 
     virtual LteFeedbackVector computeFeedback(const Remote remote, FeedbackType fbType,
         RbAllocationType rbAllocationType, TxMode currentTxMode,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0);
+        const std::vector<double>& snr, MacNodeId id = 0);
 
     virtual LteFeedback computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
         RbAllocationType rbAllocationType,
         int antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
-        std::vector<double> snr, MacNodeId id = 0);
+        const std::vector<double>& snr, MacNodeId id = 0);
 };
 
 #endif
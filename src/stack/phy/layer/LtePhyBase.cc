@@ -9,6 +9,7 @@
 
 #include "stack/phy/layer/LtePhyBase.h"
 #include "common/LteCommon.h"
+#include <algorithm>
 
 short LtePhyBase::airFramePriority_ = 10;
 
@@ -260,16 +261,96 @@ void LtePhyBase::sendBroadcast(LteAirFrame *airFrame)
 //    }
 }
 
+void LtePhyBase::sendMulticast(LteAirFrame *airFrame)
+{
+    UserControlInfo *ci = check_and_cast<UserControlInfo *>(airFrame->getControlInfo());
+    MacNodeId destId = ci->getDestId();
+    int32 groupId = ci->getMulticastGroupId();
+
+    const ChannelControl::RadioRefVector& neighbors = getRadioNeighbors();
+    const std::vector<MacNodeId>* members = binder_->getMulticastGroupMembers(groupId);
+    unsigned int numMembers = (members != NULL) ? members->size() : 0;
+
+    // select the receivers (as positions in the list of neighbors) before duplicating the frame
+    std::vector<unsigned int> receivers;
+    if (numMembers + 1 < neighbors.size())
+    {
+        // look up the members (and the destination) among the NICs in range
+        for (unsigned int i = 0; i < numMembers; i++)
+        {
+            int pos = findRadioNeighbor(neighbors, (*members)[i]);
+            if (pos >= 0)
+                receivers.push_back(pos);
+        }
+        if (!binder_->isInMulticastGroup(destId, groupId))
+        {
+            int pos = findRadioNeighbor(neighbors, destId);
+            if (pos >= 0)
+                receivers.push_back(pos);
+        }
+        // send in the same order as the list of neighbors
+        std::sort(receivers.begin(), receivers.end());
+    }
+    else
+    {
+        for (unsigned int i = 0; i < neighbors.size(); i++)
+        {
+            LtePhyBase *phy = dynamic_cast<LtePhyBase *>(neighbors[i]->radioModule);
+            if (phy == NULL)
+                continue;
+            MacNodeId id = phy->getMacNodeId();
+            if (id != destId && !binder_->isInMulticastGroup(id, groupId))
+                continue;
+            receivers.push_back(i);
+        }
+    }
+
+    EV << "LtePhyBase::sendMulticast - group " << groupId << ": " << receivers.size() << " receivers out of "
+       << neighbors.size() << " NICs in range" << endl;
+
+    if (receivers.empty())
+    {
+        delete airFrame;
+        return;
+    }
+
+    // the encapsulated packet is shared among the copies
+    unsigned int last = receivers.size() - 1;
+    for (unsigned int i = 0; i < last; i++)
+        sendDirect(airFrame->dup(), 0, airFrame->getDuration(), neighbors[receivers[i]]->radioInGate);
+    sendDirect(airFrame, 0, airFrame->getDuration(), neighbors[receivers[last]]->radioInGate);
+}
+
+int LtePhyBase::findRadioNeighbor(const ChannelControl::RadioRefVector& neighbors, MacNodeId id)
+{
+    LtePhyBase *phy = binder_->getPhyFromMacNodeId(id);
+    if (phy == NULL || phy == this)
+        return -1;
+
+    // the list of neighbors is sorted by module id
+    int moduleId = phy->getId();
+    unsigned int lb = 0, ub = neighbors.size();
+    while (lb < ub)
+    {
+        unsigned int mid = (lb + ub) / 2;
+        if (neighbors[mid]->radioModule->getId() < moduleId)
+            lb = mid + 1;
+        else
+            ub = mid;
+    }
+    if (lb < neighbors.size() && neighbors[lb]->radioModule == phy)
+        return lb;
+    return -1;
+}
+
 LteAmc *LtePhyBase::getAmcModule(MacNodeId id)
 {
     LteAmc *amc = NULL;
-    OmnetId omid = binder_->getOmnetId(id);
-    if (omid == 0)
+    LteMacBase *mac = binder_->getMacFromMacNodeId(id);
+    if (mac == NULL)
         return NULL;
 
-    amc = check_and_cast<LteMacEnb *>(
-        getSimulation()->getModule(omid)->getSubmodule("lteNic")->getSubmodule(
-            "mac"))->getAmc();
+    amc = check_and_cast<LteMacEnb *>(mac)->getAmc();
     return amc;
 }
 
@@ -286,14 +367,13 @@ void LtePhyBase::sendUnicast(LteAirFrame *frame)
         delete frame;
         return;         // make sure that nodes that left the simulation do not send
     }
-    OmnetId destOmnetId = binder_->getOmnetId(dest);
-    if (destOmnetId == 0){
+    // get a pointer to receiving module
+    cModule *receiver = binder_->getNodeFromMacNodeId(dest);
+    if (receiver == NULL){
         // destination node has left the simulation
         delete frame;
         return;
     }
-    // get a pointer to receiving module
-    cModule *receiver = getSimulation()->getModule(destOmnetId);
     // receiver's gate
     sendDirect(frame, 0, frame->getDuration(), receiver, "radioIn");
 
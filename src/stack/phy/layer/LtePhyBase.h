@@ -201,6 +201,24 @@ class LtePhyBase : public ChannelAccess
      */
     virtual void sendBroadcast(LteAirFrame *airFrame);
 
+    /**
+     * Sends a frame to the NICs in range that belong to the multicast group
+     * specified in carried control info (or whose MacNodeId is the destination).
+     *
+     * Receivers are selected before the frame is duplicated, so the other
+     * NICs in range do not receive (and discard) a copy. The last receiver
+     * gets the original frame.
+     * If the group has fewer members than the NICs in range, only the members
+     * are looked up among the NICs in range.
+     */
+    virtual void sendMulticast(LteAirFrame *airFrame);
+
+    /*
+     * Returns the position of the given node in the (sorted) list of radios in range,
+     * -1 if the node is not in range
+     */
+    int findRadioNeighbor(const ChannelControl::RadioRefVector& neighbors, MacNodeId id);
+
     /**
      * Sends a frame uniquely to the dest specified in carried control info.
      *
@@ -315,17 +333,23 @@ class LtePhyBase : public ChannelAccess
      */
     void updateDisplayString();
 
-    /**
-     * Simple utility function to create a broadcast message for handover.
-     */
-    LteAirFrame *createHandoverMessage();
-
     /**
      * Returns the pointer to the AMC module, given a master ID (ENODEB or RELAY)
      */
     LteAmc *getAmcModule(MacNodeId id);
 
   public:
+    /**
+     * Simple utility function to create a broadcast message for handover.
+     */
+    LteAirFrame *createHandoverMessage();
+    /*
+     * Returns the radios within interference distance of this node
+     */
+    const ChannelControl::RadioRefVector& getRadioNeighbors()
+    {
+        return check_and_cast<ChannelControl *>(cc)->getNeighbors(myRadioRef);
+    }
     /*
      * Returns the current position of the node
      */
@@ -334,6 +358,10 @@ class LtePhyBase : public ChannelAccess
      * Returns the time of the last transmission performed
      */
     simtime_t getLastActive() { return lastActive_; }
+    /*
+     * Returns the MacNodeId of the node
+     */
+    MacNodeId getMacNodeId() const { return nodeId_; }
 };
 
 #endif  /* _LTE_AIRPHYBASE_H_ */
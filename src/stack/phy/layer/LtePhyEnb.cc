@@ -18,11 +18,19 @@ LtePhyEnb::LtePhyEnb()
 {
     das_ = NULL;
     bdcStarter_ = NULL;
+    batchFeedback_ = false;
+    feedbackBatchTimer_ = NULL;
 }
 
 LtePhyEnb::~LtePhyEnb()
 {
     cancelAndDelete(bdcStarter_);
+    cancelAndDelete(feedbackBatchTimer_);
+    for (unsigned int i = 0; i < pendingFeedback_.size(); i++)
+    {
+        delete pendingFeedback_[i].first;
+        delete pendingFeedback_[i].second;
+    }
     if(lteFeedbackComputation_){
         delete lteFeedbackComputation_;
         lteFeedbackComputation_ = NULL;
@@ -54,6 +62,10 @@ void LtePhyEnb::initialize(int stage)
         deployer_->channelUpdate(nodeId_, intuniform(1, binder_->phyPisaData.maxChannel2()));
         das_ = new DasFilter(this, binder_, deployer_->getRemoteAntennaSet(), 0);
 
+        batchFeedback_ = par("batchFeedback");
+        if (batchFeedback_)
+            feedbackBatchTimer_ = new cMessage("feedbackBatch");
+
         WATCH(nodeType_);
         WATCH(das_);
     }
@@ -83,9 +95,17 @@ void LtePhyEnb::initialize(int stage)
 
         bdcUpdateInterval_ = deployer_->par("broadcastMessageInterval");
         if (bdcUpdateInterval_ != 0 && par("enableHandover").boolValue()) {
-            // self message provoking the generation of a broadcast message
-            bdcStarter_ = new cMessage("bdcStarter");
-            scheduleAt(NOW, bdcStarter_);
+            if (binder_->isHandoverMeasurementCentralized())
+            {
+                // the binder evaluates the handover frame at the UEs, no broadcast message is sent
+                binder_->registerHandoverMeasurementCell(this, bdcUpdateInterval_);
+            }
+            else
+            {
+                // self message provoking the generation of a broadcast message
+                bdcStarter_ = new cMessage("bdcStarter");
+                scheduleAt(NOW, bdcStarter_);
+            }
         }
     }
 }
@@ -99,6 +119,10 @@ void LtePhyEnb::handleSelfMessage(cMessage *msg)
         sendBroadcast(f);
         scheduleAt(NOW + bdcUpdateInterval_, msg);
     }
+    else if (msg->isName("feedbackBatch"))
+    {
+        computeFeedbackBatch();
+    }
     else
     {
         delete msg;
@@ -136,7 +160,6 @@ bool LtePhyEnb::handleControlPkt(UserControlInfo* lteinfo, LteAirFrame* frame)
     if (lteinfo->getFrameType() == FEEDBACKPKT)
     {
         handleFeedbackPkt(lteinfo, frame);
-        delete frame;
         return true;
     }
     return false;
@@ -256,17 +279,13 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
 
     //Apply analog model (pathloss)
     //Get snr for UL direction
-    std::vector<double> snr = channelModel_->getSINR(frame, lteinfo);
+    fbSnr_ = channelModel_->getSINR(frame, lteinfo);
     FeedbackRequest req = lteinfo->feedbackReq;
     //Feedback computation
     fb_.clear();
-    //get number of RU
-    int nRus = deployer_->getNumRus();
     TxMode txmode = req.txMode;
     FeedbackType type = req.type;
     RbAllocationType rbtype = req.rbAllocationType;
-    std::map<Remote, int> antennaCws = deployer_->getAntennaCws();
-    unsigned int numPreferredBand = deployer_->getNumPreferredBands();
     for (Direction dir = UL; dir != UNKNOWN_DIRECTION;
         dir = ((dir == UL )? DL : UNKNOWN_DIRECTION))
     {
@@ -274,7 +293,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
         if (req.genType == IDEAL)
         {
             fb_ = lteFeedbackComputation_->computeFeedback(type, rbtype, txmode,
-                antennaCws, numPreferredBand, IDEAL, nRus, snr,
+                fbAntennaCws_, fbNumPreferredBands_, IDEAL, fbNumRus_, fbSnr_,
                 lteinfo->getSourceId());
         }
         else if (req.genType == REAL)
@@ -287,8 +306,8 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
                 fb_[(*it)].resize((int) txmode);
                 fb_[(*it)][(int) txmode] =
                 lteFeedbackComputation_->computeFeedback(*it, txmode,
-                    type, rbtype, antennaCws[*it], numPreferredBand,
-                    REAL, nRus, snr, lteinfo->getSourceId());
+                    type, rbtype, fbAntennaCws_[*it], fbNumPreferredBands_,
+                    REAL, fbNumRus_, fbSnr_, lteinfo->getSourceId());
             }
         }
         // the reports are computed only for the antenna in the reporting set
@@ -300,8 +319,8 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
                 it != das_->getReportingSet().end(); ++it)
             {
                 fb_[(*it)] = lteFeedbackComputation_->computeFeedback(*it, type,
-                    rbtype, txmode, antennaCws[*it], numPreferredBand,
-                    DAS_AWARE, nRus, snr, lteinfo->getSourceId());
+                    rbtype, txmode, fbAntennaCws_[*it], fbNumPreferredBands_,
+                    DAS_AWARE, fbNumRus_, fbSnr_, lteinfo->getSourceId());
             }
         }
         if (dir == UL)
@@ -312,7 +331,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
             lteinfo->setDirection(DL);
 
             //Get snr for DL direction
-            snr = channelModel_->getSINR(frame, lteinfo);
+            fbSnr_ = channelModel_->getSINR(frame, lteinfo);
         }
         else
         pkt->setLteFeedbackDoubleVectorDl(fb_);
@@ -322,21 +341,59 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
        << fbGeneratorTypeToA(req.genType) << " Fb size: " << fb_.size() << endl;
 }
 
+void LtePhyEnb::updateFeedbackParameters()
+{
+    //get number of RU
+    fbNumRus_ = deployer_->getNumRus();
+    fbAntennaCws_ = deployer_->getAntennaCws();
+    fbNumPreferredBands_ = deployer_->getNumPreferredBands();
+}
+
 void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
     LteAirFrame *frame)
 {
     EV << "Handled Feedback Packet with ID " << frame->getId() << endl;
     LteFeedbackPkt* pkt = check_and_cast<LteFeedbackPkt*>(frame->decapsulate());
-    // here frame has to be destroyed since it is no more useful
     pkt->setControlInfo(lteinfo);
+
+    // feedback generated by dummy phy is sent up as it is
+    if (lteinfo->feedbackReq.request && batchFeedback_)
+    {
+        // the feedback is computed at the end of the TTI, together with the other ones received in this TTI
+        pendingFeedback_.push_back(std::make_pair(pkt, frame));
+        if (!feedbackBatchTimer_->isScheduled())
+            scheduleAt(NOW, feedbackBatchTimer_);
+        return;
+    }
+
+    if (lteinfo->feedbackReq.request)
+        updateFeedbackParameters();
+    computeFeedbackPkt(pkt, frame);
+}
+
+void LtePhyEnb::computeFeedbackBatch()
+{
+    EV << NOW << " LtePhyEnb::computeFeedbackBatch - computing " << pendingFeedback_.size() << " feedback reports" << endl;
+
+    // cell parameters are the same for all the reports of the batch
+    updateFeedbackParameters();
+
+    for (unsigned int i = 0; i < pendingFeedback_.size(); i++)
+        computeFeedbackPkt(pendingFeedback_[i].first, pendingFeedback_[i].second);
+    pendingFeedback_.clear();
+}
+
+void LtePhyEnb::computeFeedbackPkt(LteFeedbackPkt* pkt, LteAirFrame* frame)
+{
+    UserControlInfo* lteinfo = check_and_cast<UserControlInfo*>(pkt->getControlInfo());
     // if feedback was generated by dummy phy we can send up to mac else nodeb should generate the "real" feddback
     if (lteinfo->feedbackReq.request)
     {
         requestFeedback(lteinfo, frame, pkt);
         //DEBUG
-        LteFeedbackDoubleVector::iterator it;
-        LteFeedbackVector::iterator jt;
-        LteFeedbackDoubleVector vec = pkt->getLteFeedbackDoubleVectorDl();
+        LteFeedbackDoubleVector::const_iterator it;
+        LteFeedbackVector::const_iterator jt;
+        const LteFeedbackDoubleVector& vec = pkt->getLteFeedbackDoubleVectorDl();
         for (it = vec.begin(); it != vec.end(); ++it)
         {
             for (jt = it->begin(); jt != it->end(); ++jt)
@@ -347,23 +404,16 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
                 EV << "TXMODE: " << txModeToA(t) << endl;
                 if (jt->hasBandCqi())
                 {
-                    std::vector<CqiVector> vec = jt->getBandCqi();
-                    std::vector<CqiVector>::iterator kt;
-                    CqiVector::iterator ht;
-                    int i;
-                    for (kt = vec.begin(); kt != vec.end(); ++kt)
+                    for (unsigned int cw = 0; cw < jt->getBandCqiCodewords(); cw++)
                     {
-                        for (i = 0, ht = kt->begin(); ht != kt->end();
-                            ++ht, i++)
-                        EV << "Banda " << i << " Cqi " << *ht << endl;
+                        for (unsigned int i = 0; i < jt->getNumBands(); i++)
+                            EV << "Banda " << i << " Cqi " << jt->getBandCqi(cw, i) << endl;
                     }
                 }
                 else if (jt->hasWbCqi())
                 {
-                    CqiVector v = jt->getWbCqi();
-                    CqiVector::iterator ht = v.begin();
-                    for (; ht != v.end(); ++ht)
-                    EV << "wb cqi " << *ht << endl;
+                    for (unsigned int cw = 0; cw < jt->getWbCqiCodewords(); cw++)
+                        EV << "wb cqi " << jt->getWbCqi(cw) << endl;
                 }
                 if (jt->hasRankIndicator())
                 {
@@ -372,6 +422,8 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
             }
         }
     }
+    // here frame has to be destroyed since it is no more useful
+    delete frame;
     // send decapsulated message along with result control info to upperGateOut_
     send(pkt, upperGateOut_);
 }
@@ -35,13 +35,46 @@ class LtePhyEnb : public LtePhyBase
     //Used for PisaPhy feedback generator
     LteFeedbackDoubleVector fb_;
 
+    /*
+     * Batched feedback computation
+     */
+    // if true, the feedback packets received in the same TTI are computed together
+    bool batchFeedback_;
+    // self message triggering the computation of the pending feedback at the end of the TTI
+    cMessage* feedbackBatchTimer_;
+    // feedback packets waiting to be computed (with the frame they were received in), in order of arrival
+    std::vector<std::pair<LteFeedbackPkt*, LteAirFrame*> > pendingFeedback_;
+
+    // cell parameters used by the feedback computation, read once per batch
+    int fbNumRus_;
+    std::map<Remote, int> fbAntennaCws_;
+    unsigned int fbNumPreferredBands_;
+    // SINR vector of the feedback being computed
+    std::vector<double> fbSnr_;
+
     virtual void initialize(int stage);
 
     virtual void handleSelfMessage(cMessage *msg);
     virtual void handleAirFrame(cMessage* msg);
     bool handleControlPkt(UserControlInfo* lteinfo, LteAirFrame* frame);
+    /**
+     * Computes the feedback carried by the given frame (or queues it, if
+     * feedback is batched) and sends it to the MAC. The frame is deleted
+     */
     void handleFeedbackPkt(UserControlInfo* lteinfo, LteAirFrame* frame);
     virtual void requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, LteFeedbackPkt* pkt);
+    /**
+     * Reads the cell parameters used by requestFeedback() from the deployer
+     */
+    virtual void updateFeedbackParameters();
+    /**
+     * Computes the feedback of all the packets received in the current TTI
+     */
+    void computeFeedbackBatch();
+    /**
+     * Computes the feedback carried by the given packet and sends it to the MAC
+     */
+    void computeFeedbackPkt(LteFeedbackPkt* pkt, LteAirFrame* frame);
     /**
      * Getter for the Das Filter
      */
@@ -29,6 +29,24 @@ void LtePhyEnbD2D::initialize(int stage)
         enableD2DCqiReporting_ = par("enableD2DCqiReporting");
 }
 
+void LtePhyEnbD2D::updateFeedbackParameters()
+{
+    LtePhyEnb::updateFeedbackParameters();
+
+    fbCellUes_.clear();
+    if (!enableD2DCqiReporting_)
+        return;
+
+    // only in-cell D2D peers are considered
+    std::vector<UeInfo*>* ueList = binder_->getUeList();
+    std::vector<UeInfo*>::iterator it = ueList->begin();
+    for (; it != ueList->end(); ++it)
+    {
+        if (binder_->getNextHop((*it)->id) == nodeId_)
+            fbCellUes_.push_back(*it);
+    }
+}
+
 void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, LteFeedbackPkt* pkt)
 {
     EV << NOW << " LtePhyEnbD2D::requestFeedback " << endl;
@@ -38,17 +56,13 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
 
     //Apply analog model (pathloss)
     //Get snr for UL direction
-    std::vector<double> snr = channelModel_->getSINR(frame, lteinfo);
+    fbSnr_ = channelModel_->getSINR(frame, lteinfo);
     FeedbackRequest req = lteinfo->feedbackReq;
     //Feedback computation
     fb_.clear();
-    //get number of RU
-    int nRus = deployer_->getNumRus();
     TxMode txmode = req.txMode;
     FeedbackType type = req.type;
     RbAllocationType rbtype = req.rbAllocationType;
-    std::map<Remote, int> antennaCws = deployer_->getAntennaCws();
-    unsigned int numPreferredBand = deployer_->getNumPreferredBands();
     Direction dir = UL;
     while (dir != UNKNOWN_DIRECTION)
     {
@@ -56,7 +70,7 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
         if (req.genType == IDEAL)
         {
             fb_ = lteFeedbackComputation_->computeFeedback(type, rbtype, txmode,
-                antennaCws, numPreferredBand, IDEAL, nRus, snr,
+                fbAntennaCws_, fbNumPreferredBands_, IDEAL, fbNumRus_, fbSnr_,
                 lteinfo->getSourceId());
         }
         else if (req.genType == REAL)
@@ -69,8 +83,8 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
                 fb_[(*it)].resize((int) txmode);
                 fb_[(*it)][(int) txmode] =
                 lteFeedbackComputation_->computeFeedback(*it, txmode,
-                    type, rbtype, antennaCws[*it], numPreferredBand,
-                    REAL, nRus, snr, lteinfo->getSourceId());
+                    type, rbtype, fbAntennaCws_[*it], fbNumPreferredBands_,
+                    REAL, fbNumRus_, fbSnr_, lteinfo->getSourceId());
             }
         }
         // the reports are computed only for the antenna in the reporting set
@@ -82,8 +96,8 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
                 it != das_->getReportingSet().end(); ++it)
             {
                 fb_[(*it)] = lteFeedbackComputation_->computeFeedback(*it, type,
-                    rbtype, txmode, antennaCws[*it], numPreferredBand,
-                    DAS_AWARE, nRus, snr, lteinfo->getSourceId());
+                    rbtype, txmode, fbAntennaCws_[*it], fbNumPreferredBands_,
+                    DAS_AWARE, fbNumRus_, fbSnr_, lteinfo->getSourceId());
             }
         }
         if (dir == UL)
@@ -94,7 +108,7 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
             lteinfo->setDirection(DL);
 
             //Get snr for DL direction
-            snr = channelModel_->getSINR(frame, lteinfo);
+            fbSnr_ = channelModel_->getSINR(frame, lteinfo);
 
             dir = DL;
         }
@@ -105,12 +119,11 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
             if (enableD2DCqiReporting_)
             {
                 // compute D2D feedback for all possible peering UEs
-                std::vector<UeInfo*>* ueList = binder_->getUeList();
-                std::vector<UeInfo*>::iterator it = ueList->begin();
-                for (; it != ueList->end(); ++it)
+                std::vector<UeInfo*>::iterator it = fbCellUes_.begin();
+                for (; it != fbCellUes_.end(); ++it)
                 {
                     MacNodeId peerId = (*it)->id;
-                    if (peerId != lteinfo->getSourceId() && binder_->checkD2DCapability(lteinfo->getSourceId(), peerId) && binder_->getNextHop(peerId) == nodeId_)
+                    if (peerId != lteinfo->getSourceId() && binder_->checkD2DCapability(lteinfo->getSourceId(), peerId))
                     {
                          // the source UE might communicate with this peer using D2D, so compute feedback (only in-cell D2D)
 
@@ -118,11 +131,11 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
                          Coord peerCoord = (*it)->phy->getCoord();
 
                          // get SINR for this link
-                         snr = channelModel_->getSINR_D2D(frame, lteinfo, peerId, peerCoord, nodeId_);
+                         fbSnr_ = channelModel_->getSINR_D2D(frame, lteinfo, peerId, peerCoord, nodeId_);
 
                          // compute the feedback for this link
                          fb_ = lteFeedbackComputation_->computeFeedback(type, rbtype, txmode,
-                                 antennaCws, numPreferredBand, IDEAL, nRus, snr,
+                                 fbAntennaCws_, fbNumPreferredBands_, IDEAL, fbNumRus_, fbSnr_,
                                  lteinfo->getSourceId());
 
                          pkt->setLteFeedbackDoubleVectorD2D(peerId, fb_);
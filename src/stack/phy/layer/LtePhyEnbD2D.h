@@ -18,9 +18,13 @@ class LtePhyEnbD2D : public LtePhyEnb
 
     bool enableD2DCqiReporting_;
 
+    // UEs served by this cell, candidate D2D peers for the feedback computation. Read once per batch
+    std::vector<UeInfo*> fbCellUes_;
+
   protected:
 
     virtual void initialize(int stage);
+    virtual void updateFeedbackParameters();
     virtual void requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, LteFeedbackPkt* pkt);
     virtual void handleAirFrame(cMessage* msg);
 
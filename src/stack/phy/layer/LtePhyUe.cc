@@ -107,7 +107,7 @@ void LtePhyUe::initialize(int stage)
             for (; it != enbList->end(); ++it)
             {
                 MacNodeId cellId = (*it)->id;
-                LtePhyBase* cellPhy = check_and_cast<LtePhyBase*>((*it)->eNodeB->getSubmodule("lteNic")->getSubmodule("phy"));
+                LtePhyBase* cellPhy = binder_->getPhyFromMacNodeId(cellId);
                 double cellTxPower = cellPhy->getTxPwr();
                 Coord cellPos = cellPhy->getCoord();
 
@@ -181,6 +181,27 @@ void LtePhyUe::handleSelfMessage(cMessage *msg)
 void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
 {
     lteInfo->setDestId(nodeId_);
+    frame->setControlInfo(lteInfo);
+    processHandoverFrame(frame, lteInfo);
+    delete frame;
+}
+
+void LtePhyUe::receiveHandoverMeasurement(LteAirFrame* frame, UserControlInfo* lteInfo)
+{
+    Enter_Method_Silent();
+
+    connectedNodeId_ = masterId_;
+
+    // check if handover is already in process
+    if (handoverTrigger_ != NULL && handoverTrigger_->isScheduled())
+        return;
+
+    lteInfo->setDestId(nodeId_);
+    processHandoverFrame(frame, lteInfo);
+}
+
+void LtePhyUe::processHandoverFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
+{
     if (!enableHandover_)
     {
         // Even if handover is not enabled, this call is necessary
@@ -190,15 +211,10 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
             // Broadcast message from my master enb
             das_->receiveBroadcast(frame, lteInfo);
         }
-
-        delete frame;
-        delete lteInfo;
         return;
     }
 
-    frame->setControlInfo(lteInfo);
     double rssi;
-
     if (getNodeTypeById(lteInfo->getSourceId()) == ENODEB && lteInfo->getSourceId() == masterId_)
     {
         // Broadcast message from my master enb
@@ -253,8 +269,6 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
             hysteresisTh_ = updateHysteresisTh(rssi);
         }
     }
-
-    delete frame;
 }
 
 void LtePhyUe::triggerHandover()
@@ -274,7 +288,7 @@ void LtePhyUe::triggerHandover()
     binder_->addUeHandoverTriggered(nodeId_);
 
     // inform the eNB's IP2lte module to forward data to the target eNB
-    IP2lte* enbIp2lte =  check_and_cast<IP2lte*>(getSimulation()->getModule(binder_->getOmnetId(masterId_))->getSubmodule("lteNic")->getSubmodule("ip2lte"));
+    IP2lte* enbIp2lte =  check_and_cast<IP2lte*>(binder_->getIp2lteFromMacNodeId(masterId_));
     enbIp2lte->triggerHandoverSource(nodeId_,candidateMasterId_);
 
     handoverTrigger_ = new cMessage("handoverTrigger");
@@ -315,7 +329,7 @@ void LtePhyUe::doHandover()
     hysteresisTh_ = updateHysteresisTh(currentMasterRssi_);
 
     // update deployer
-    LteMacEnb* newMacEnb =  check_and_cast<LteMacEnb*>(getSimulation()->getModule(binder_->getOmnetId(candidateMasterId_))->getSubmodule("lteNic")->getSubmodule("mac"));
+    LteMacEnb* newMacEnb =  check_and_cast<LteMacEnb*>(binder_->getMacFromMacNodeId(candidateMasterId_));
     LteDeployer* newDeployer = newMacEnb->getDeployer();
     deployer_->detachUser(nodeId_);
     newDeployer->attachUser(nodeId_);
@@ -335,7 +349,7 @@ void LtePhyUe::doHandover()
     binder_->removeUeHandoverTriggered(nodeId_);
 
     // inform the eNB's IP2lte module to forward data to the target eNB
-    IP2lte* enbIp2lte =  check_and_cast<IP2lte*>(getSimulation()->getModule(binder_->getOmnetId(masterId_))->getSubmodule("lteNic")->getSubmodule("ip2lte"));
+    IP2lte* enbIp2lte =  check_and_cast<IP2lte*>(binder_->getIp2lteFromMacNodeId(masterId_));
     enbIp2lte->signalHandoverCompleteTarget(nodeId_,oldMaster);
 
     // TODO: transfer buffers
@@ -503,6 +517,7 @@ void LtePhyUe::handleUpperMessage(cMessage* msg)
             ++it;
     }
     lastActive_ = NOW;
+    binder_->registerTransmission(nodeId_, rbMap);
 
     if (lteInfo->getFrameType() == DATAPKT && lteInfo->getUserTxParams() != NULL)
     {
@@ -548,13 +563,10 @@ double LtePhyUe::updateHysteresisTh(double v)
 
 void LtePhyUe::deleteOldBuffers(MacNodeId masterId)
 {
-    OmnetId masterOmnetId = binder_->getOmnetId(masterId);
-
     /* Delete Mac Buffers */
 
     // delete macBuffer[nodeId_] at old master
-    LteMacEnb *masterMac = check_and_cast<LteMacEnb *>(getSimulation()->getModule(masterOmnetId)->
-    getSubmodule("lteNic")->getSubmodule("mac"));
+    LteMacEnb *masterMac = check_and_cast<LteMacEnb *>(binder_->getMacFromMacNodeId(masterId));
     masterMac->deleteQueues(nodeId_);
 
     // delete queues for master at this ue
@@ -563,8 +575,7 @@ void LtePhyUe::deleteOldBuffers(MacNodeId masterId)
     /* Delete Rlc UM Buffers */
 
     // delete UmTxQueue[nodeId_] at old master
-    LteRlcUm *masterRlcUm = check_and_cast<LteRlcUm *>(getSimulation()->getModule(masterOmnetId)->
-    getSubmodule("lteNic")->getSubmodule("rlc")->getSubmodule("um"));
+    LteRlcUm *masterRlcUm = check_and_cast<LteRlcUm *>(getRlcByMacNodeId(masterId, UM));
     masterRlcUm->deleteQueues(nodeId_);
 
     // delete queues for master at this ue
@@ -576,7 +587,7 @@ DasFilter* LtePhyUe::getDasFilter()
     return das_;
 }
 
-void LtePhyUe::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req)
+void LtePhyUe::sendFeedback(const LteFeedbackDoubleVector& fbDl, const LteFeedbackDoubleVector& fbUl, FeedbackRequest req)
 {
     Enter_Method("SendFeedback");
     EV << "LtePhyUe: feedback from Feedback Generator" << endl;
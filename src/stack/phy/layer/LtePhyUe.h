@@ -125,6 +125,12 @@ class LtePhyUe : public LtePhyBase
 
     void handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo);
 
+    /**
+     * Computes the RSSI of the handover frame and updates the handover candidate.
+     * Does not take ownership of frame and lteInfo
+     */
+    void processHandoverFrame(LteAirFrame* frame, UserControlInfo* lteInfo);
+
     void deleteOldBuffers(MacNodeId masterId);
 
     virtual void triggerHandover();
@@ -134,10 +140,15 @@ class LtePhyUe : public LtePhyBase
     LtePhyUe();
     virtual ~LtePhyUe();
     DasFilter *getDasFilter();
+    /**
+     * Evaluates a handover frame on behalf of the binder (centralized handover measurement).
+     * The frame is shared among UEs and is not deleted
+     */
+    void receiveHandoverMeasurement(LteAirFrame* frame, UserControlInfo* lteInfo);
     /**
      * Send Feedback, called by feedback generator in DL
      */
-    virtual void sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req);
+    virtual void sendFeedback(const LteFeedbackDoubleVector& fbDl, const LteFeedbackDoubleVector& fbUl, FeedbackRequest req);
     MacNodeId getMasterId() const
     {
         return masterId_;
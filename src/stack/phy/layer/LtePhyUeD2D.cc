@@ -207,8 +207,7 @@ void LtePhyUeD2D::triggerHandover()
     // currently, DM is possible only for UEs served by the same cell
 
     // trigger D2D mode switch
-    cModule* enb = getSimulation()->getModule(binder_->getOmnetId(masterId_));
-    D2DModeSelectionBase *d2dModeSelection = check_and_cast<D2DModeSelectionBase*>(enb->getSubmodule("lteNic")->getSubmodule("d2dModeSelection"));
+    D2DModeSelectionBase *d2dModeSelection = check_and_cast<D2DModeSelectionBase*>(binder_->getD2DModeSelectionFromMacNodeId(masterId_));
     d2dModeSelection->doModeSwitchAtHandover(nodeId_, false);
 
     LtePhyUe::triggerHandover();
@@ -226,8 +225,7 @@ void LtePhyUeD2D::doHandover()
     LtePhyUe::doHandover();
 
     // call mode selection module to check if DM connections are possible
-    cModule* enb = getSimulation()->getModule(binder_->getOmnetId(masterId_));
-    D2DModeSelectionBase *d2dModeSelection = check_and_cast<D2DModeSelectionBase*>(enb->getSubmodule("lteNic")->getSubmodule("d2dModeSelection"));
+    D2DModeSelectionBase *d2dModeSelection = check_and_cast<D2DModeSelectionBase*>(binder_->getD2DModeSelectionFromMacNodeId(masterId_));
     d2dModeSelection->doModeSwitchAtHandover(nodeId_, true);
 }
 
@@ -256,6 +254,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage* msg)
             ++it;
     }
     lastActive_ = NOW;
+    binder_->registerTransmission(nodeId_, rbMap);
 
     if (lteInfo->getFrameType() == DATAPKT && lteInfo->getUserTxParams() != NULL)
     {
@@ -295,10 +294,10 @@ void LtePhyUeD2D::handleUpperMessage(cMessage* msg)
     EV << "LtePhyUeD2D::handleUpperMessage - " << nodeTypeToA(nodeType_) << " with id " << nodeId_
        << " sending message to the air channel. Dest=" << lteInfo->getDestId() << endl;
 
-    // if this is a multicast/broadcast connection, send the frame to all neighbors in the hearing range
+    // if this is a multicast/broadcast connection, send the frame to the group members in the hearing range
     // otherwise, send unicast to the destination
     if (lteInfo->getDirection() == D2D_MULTI)
-        sendBroadcast(frame);
+        sendMulticast(frame);
     else
         sendUnicast(frame);
 }
@@ -470,7 +469,7 @@ void LtePhyUeD2D::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
 }
 
 
-void LtePhyUeD2D::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req)
+void LtePhyUeD2D::sendFeedback(const LteFeedbackDoubleVector& fbDl, const LteFeedbackDoubleVector& fbUl, FeedbackRequest req)
 {
     Enter_Method("SendFeedback");
     EV << "LtePhyUeD2D: feedback from Feedback Generator" << endl;
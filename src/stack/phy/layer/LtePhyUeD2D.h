@@ -47,7 +47,7 @@ class LtePhyUeD2D : public LtePhyUe
     LtePhyUeD2D();
     virtual ~LtePhyUeD2D();
 
-    virtual void sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req);
+    virtual void sendFeedback(const LteFeedbackDoubleVector& fbDl, const LteFeedbackDoubleVector& fbUl, FeedbackRequest req);
     virtual double getTxPwr(Direction dir = UNKNOWN_DIRECTION)
     {
         if (dir == D2D)
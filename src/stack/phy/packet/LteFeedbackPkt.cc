@@ -9,27 +9,27 @@
 
 #include "stack/phy/packet/LteFeedbackPkt.h"
 
-LteFeedbackDoubleVector LteFeedbackPkt::getLteFeedbackDoubleVectorDl()
+const LteFeedbackDoubleVector& LteFeedbackPkt::getLteFeedbackDoubleVectorDl() const
 {
     return lteFeedbackDoubleVectorDl_;
 }
-LteFeedbackDoubleVector LteFeedbackPkt::getLteFeedbackDoubleVectorUl()
+const LteFeedbackDoubleVector& LteFeedbackPkt::getLteFeedbackDoubleVectorUl() const
 {
     return lteFeedbackDoubleVectorUl_;
 }
-std::map<MacNodeId, LteFeedbackDoubleVector> LteFeedbackPkt::getLteFeedbackDoubleVectorD2D()
+const std::map<MacNodeId, LteFeedbackDoubleVector>& LteFeedbackPkt::getLteFeedbackDoubleVectorD2D() const
 {
     return lteFeedbackMapDoubleVectorD2D_;
 }
-void LteFeedbackPkt::setLteFeedbackDoubleVectorDl(LteFeedbackDoubleVector lteFeedbackDoubleVector)
+void LteFeedbackPkt::setLteFeedbackDoubleVectorDl(const LteFeedbackDoubleVector& lteFeedbackDoubleVector)
 {
     lteFeedbackDoubleVectorDl_ = lteFeedbackDoubleVector;
 }
-void LteFeedbackPkt::setLteFeedbackDoubleVectorUl(LteFeedbackDoubleVector lteFeedbackDoubleVector)
+void LteFeedbackPkt::setLteFeedbackDoubleVectorUl(const LteFeedbackDoubleVector& lteFeedbackDoubleVector)
 {
     lteFeedbackDoubleVectorUl_ = lteFeedbackDoubleVector;
 }
-void LteFeedbackPkt::setLteFeedbackDoubleVectorD2D(MacNodeId peerId, LteFeedbackDoubleVector lteFeedbackDoubleVector)
+void LteFeedbackPkt::setLteFeedbackDoubleVectorD2D(MacNodeId peerId, const LteFeedbackDoubleVector& lteFeedbackDoubleVector)
 {
     lteFeedbackMapDoubleVectorD2D_[peerId] = lteFeedbackDoubleVector;
 }
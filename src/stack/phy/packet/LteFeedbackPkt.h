@@ -51,12 +51,12 @@ class LteFeedbackPkt : public LteFeedbackPkt_Base
         return new LteFeedbackPkt(*this);
     }
     // ADD CODE HERE to redefine and implement pure virtual functions from LteFeedbackPkt_Base
-    LteFeedbackDoubleVector getLteFeedbackDoubleVectorDl();
-    void setLteFeedbackDoubleVectorDl(LteFeedbackDoubleVector lteFeedbackDoubleVector_);
-    LteFeedbackDoubleVector getLteFeedbackDoubleVectorUl();
-    void setLteFeedbackDoubleVectorUl(LteFeedbackDoubleVector lteFeedbackDoubleVector_);
-    std::map<MacNodeId, LteFeedbackDoubleVector> getLteFeedbackDoubleVectorD2D();
-    void setLteFeedbackDoubleVectorD2D(MacNodeId peerId, LteFeedbackDoubleVector lteFeedbackDoubleVector_);
+    const LteFeedbackDoubleVector& getLteFeedbackDoubleVectorDl() const;
+    void setLteFeedbackDoubleVectorDl(const LteFeedbackDoubleVector& lteFeedbackDoubleVector_);
+    const LteFeedbackDoubleVector& getLteFeedbackDoubleVectorUl() const;
+    void setLteFeedbackDoubleVectorUl(const LteFeedbackDoubleVector& lteFeedbackDoubleVector_);
+    const std::map<MacNodeId, LteFeedbackDoubleVector>& getLteFeedbackDoubleVectorD2D() const;
+    void setLteFeedbackDoubleVectorD2D(MacNodeId peerId, const LteFeedbackDoubleVector& lteFeedbackDoubleVector_);
     void setSourceNodeId(MacNodeId id);
     MacNodeId getSourceNodeId();
 };
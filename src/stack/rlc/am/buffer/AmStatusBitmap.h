@@ -0,0 +1,148 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_AMSTATUSBITMAP_H_
+#define _LTE_AMSTATUSBITMAP_H_
+
+#include "common/LteCommon.h"
+
+/// Number of window positions stored in a bitmap word
+#define AM_BITMAP_WORD_BITS 64
+
+/**
+ * Per-PDU status flags of an RLC AM window (e.g. received, discarded),
+ * indexed by the position of the PDU in the window.
+ *
+ * Flags are packed in 64-bit words, so that ranges of the window can be
+ * set, compared and shifted one word at a time.
+ */
+class AmStatusBitmap
+{
+  protected:
+    std::vector<uint64_t> words_;
+
+    /// number of window positions
+    unsigned int size_;
+
+  public:
+    AmStatusBitmap()
+    {
+        size_ = 0;
+    }
+
+    /// Resizes the bitmap to <size> positions, all of them cleared
+    void resize(unsigned int size)
+    {
+        size_ = size;
+        words_.assign((size + AM_BITMAP_WORD_BITS - 1) / AM_BITMAP_WORD_BITS, 0);
+    }
+
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    unsigned int numWords() const
+    {
+        return words_.size();
+    }
+
+    bool test(unsigned int i) const
+    {
+        return (words_[i / AM_BITMAP_WORD_BITS] >> (i % AM_BITMAP_WORD_BITS)) & 1;
+    }
+
+    void set(unsigned int i)
+    {
+        words_[i / AM_BITMAP_WORD_BITS] |= (uint64_t)1 << (i % AM_BITMAP_WORD_BITS);
+    }
+
+    uint64_t getWord(unsigned int w) const
+    {
+        return words_[w];
+    }
+
+    void setWord(unsigned int w, uint64_t word)
+    {
+        words_[w] = word;
+    }
+
+    /// Clears the positions in [from, to)
+    void clear(unsigned int from, unsigned int to)
+    {
+        for (unsigned int w = from / AM_BITMAP_WORD_BITS; from < to; ++w)
+        {
+            words_[w] &= ~rangeMask(w, from, to);
+            from = (w + 1) * AM_BITMAP_WORD_BITS;
+        }
+    }
+
+    /**
+     * Returns the bits of word <w> that fall in the positions [from, to)
+     *
+     * @param w word index
+     * @param from first position (included)
+     * @param to last position (excluded)
+     */
+    static uint64_t rangeMask(unsigned int w, unsigned int from, unsigned int to)
+    {
+        unsigned int lo = w * AM_BITMAP_WORD_BITS;
+        unsigned int hi = lo + AM_BITMAP_WORD_BITS;
+        if (from >= hi || to <= lo)
+            return 0;
+        uint64_t mask = ~(uint64_t)0;
+        if (from > lo)
+            mask &= ~(uint64_t)0 << (from - lo);
+        if (to < hi)
+            mask &= ~(~(uint64_t)0 << (to - lo));
+        return mask;
+    }
+
+    /**
+     * Moves the window forward by <pos> positions: position i + pos
+     * becomes position i, the last <pos> positions are cleared.
+     */
+    void shiftDown(unsigned int pos)
+    {
+        unsigned int n = words_.size();
+        unsigned int wordShift = pos / AM_BITMAP_WORD_BITS;
+        unsigned int bitShift = pos % AM_BITMAP_WORD_BITS;
+        for (unsigned int w = 0; w < n; ++w)
+        {
+            uint64_t word = 0;
+            if (w + wordShift < n)
+            {
+                word = words_[w + wordShift] >> bitShift;
+                if (bitShift > 0 && w + wordShift + 1 < n)
+                    word |= words_[w + wordShift + 1] << (AM_BITMAP_WORD_BITS - bitShift);
+            }
+            words_[w] = word;
+        }
+    }
+
+    /**
+     * Returns the first position in [0, limit) that is set in neither
+     * of the two bitmaps, or <limit> if there is none.
+     */
+    static unsigned int firstClear(const AmStatusBitmap& a, const AmStatusBitmap& b, unsigned int limit)
+    {
+        for (unsigned int w = 0; w * AM_BITMAP_WORD_BITS < limit; ++w)
+        {
+            uint64_t clear = ~(a.words_[w] | b.words_[w]);
+            if (clear != 0)
+            {
+                unsigned int i = w * AM_BITMAP_WORD_BITS + lowestSetBit(clear);
+                return (i < limit) ? i : limit;
+            }
+        }
+        return limit;
+    }
+};
+
+#endif
@@ -35,12 +35,22 @@ void AmTxQueue::initialize()
     bufferStatusTimeout_ = par("bufferStatusTimeout");
     txWindowDesc_.windowSize_ = par("txWindowSize");
     // resize status vectors
-    received_.resize(txWindowDesc_.windowSize_, false);
-    discarded_.resize(txWindowDesc_.windowSize_, false);
+    received_.resize(txWindowDesc_.windowSize_);
+    discarded_.resize(txWindowDesc_.windowSize_);
+    acked_.resize(txWindowDesc_.windowSize_);
+    pduRtxQueue_.assign(txWindowDesc_.windowSize_, NULL);
 }
 
 AmTxQueue::~AmTxQueue()
 {
+    for (unsigned int i = 0; i < pduRtxQueue_.size(); ++i)
+        delete pduRtxQueue_[i];
+    pduRtxQueue_.clear();
+
+    std::map<int, LteRlcAmPdu*>::iterator it = unackedMrw_.begin();
+    for (; it != unackedMrw_.end(); ++it)
+        delete it->second;
+    unackedMrw_.clear();
 }
 
 void AmTxQueue::enque(LteRlcAmSdu* sdu)
@@ -125,17 +135,18 @@ void AmTxQueue::addPdus()
         pdu->setTxNumber(0);
         // try the insertion into tx buffer
         int txWindowIndex = txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_;
+        unsigned int slot = txSlot(txWindowDesc_.seqNum_);
 
-        if (pduRtxQueue_.get(txWindowIndex) == NULL)
+        if (pduRtxQueue_[slot] == NULL)
         {
             // store a copy of current PDU
             LteRlcAmPdu * pduCopy = pdu->dup();
             pduCopy->setControlInfo(lteInfo->dup());
-            pduRtxQueue_.addAt(txWindowIndex, pduCopy);
+            pduRtxQueue_[slot] = pduCopy;
 
-            if (received_.at(txWindowIndex) || discarded_.at(txWindowIndex))
+            if (received_.test(txWindowIndex) || discarded_.test(txWindowIndex))
             throw cRuntimeError("AmTxQueue::addPdus(): trying to add a PDU to a  position marked received [%d] discarded [%d]",
-                (int)(received_.at(txWindowIndex)) ,(int)(discarded_.at(txWindowIndex)));
+                (int)(received_.test(txWindowIndex)) ,(int)(discarded_.test(txWindowIndex)));
         }
         else
         {
@@ -183,7 +194,7 @@ void AmTxQueue::discard(const int seqNum)
             seqNum, txWindowDesc_.firstSeqNum_);
     }
 
-    if (discarded_.at(txWindowIndex) == true)
+    if (discarded_.test(txWindowIndex) == true)
     {
         EV << " AmTxQueue::discard requested to discard an already discarded  PDU :"
         " sequence number" << seqNum << " , window first sequence is " << txWindowDesc_.firstSeqNum_ << endl;
@@ -191,11 +202,12 @@ void AmTxQueue::discard(const int seqNum)
     else
     {
         // mark current PDU for discard
-        discarded_.at(txWindowIndex) = true;
+        discarded_.set(txWindowIndex);
     }
 
-    LteRlcAmPdu* pdu = check_and_cast<LteRlcAmPdu*>(
-        pduRtxQueue_.get(txWindowIndex));
+    LteRlcAmPdu* pdu = pduRtxQueue_[txSlot(seqNum)];
+    if (pdu == NULL)
+        throw cRuntimeError("AmTxQueue::discard(): PDU %d not found", seqNum);
 
     if (pduTimer_.busy(seqNum))
         pduTimer_.remove(seqNum);
@@ -205,15 +217,15 @@ void AmTxQueue::discard(const int seqNum)
     for (int i = (txWindowIndex + 1);
         i < (txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_); ++i)
     {
-        if (pduRtxQueue_.get(i) != NULL)
+        nextPdu = pduRtxQueue_[txSlot(i + txWindowDesc_.firstSeqNum_)];
+        if (nextPdu != NULL)
         {
-            nextPdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.get(i));
             if (pdu->getSnoMainPacket() == nextPdu->getSnoMainPacket())
             {
                 // Mark the PDU to be discarded
-                if (!discarded_.at(i))
+                if (!discarded_.test(i))
                 {
-                    discarded_.at(i) = true;
+                    discarded_.set(i);
                     // Stop the timer
                     if (pduTimer_.busy(i + txWindowDesc_.firstSeqNum_))
                         pduTimer_.remove(i + txWindowDesc_.firstSeqNum_);
@@ -231,17 +243,16 @@ void AmTxQueue::discard(const int seqNum)
     // Check backward in the buffer if there are other PDUs related to the same SDU
     for (int i = txWindowIndex - 1; i >= 0; i--)
     {
-        if (pduRtxQueue_.get(i) == NULL)
+        nextPdu = pduRtxQueue_[txSlot(i + txWindowDesc_.firstSeqNum_)];
+        if (nextPdu == NULL)
             throw cRuntimeError("AmTxBuffer::discard(): trying to get access to missing PDU %d", i);
 
-        nextPdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.get(i));
-
         if (pdu->getSnoMainPacket() == nextPdu->getSnoMainPacket())
         {
-            if (!discarded_.at(i))
+            if (!discarded_.test(i))
             {
                 // Mark the PDU to be discarded
-                discarded_.at(i) = true;
+                discarded_.set(i);
             }
             // Stop the timer
             if (pduTimer_.busy(i + txWindowDesc_.firstSeqNum_))
@@ -262,25 +273,12 @@ void AmTxQueue::checkForMrw()
 
     // If there is a discarded RLC PDU at the beginning of the buffer, try
     // to move the transmitter window
-    int lastPdu = 0;
-    bool toMove = false;
-
-    for (int i = 0; i < (txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_); ++i)
-    {
-        if ((discarded_.at(i) == true) || (received_.at(i) == true))
-        {
-            lastPdu = i;
-            toMove = true;
-        }
-        else
-        {
-            break;
-        }
-    }
+    unsigned int firstPending = AmStatusBitmap::firstClear(received_, discarded_,
+        txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_);
 
-    if (toMove == true)
+    if (firstPending > 0)
     {
-        int lastSn = txWindowDesc_.firstSeqNum_ + lastPdu;
+        int lastSn = txWindowDesc_.firstSeqNum_ + firstPending - 1;
 
         EV << NOW << " AmTxQueue::checkForMrw  detected a shift from " << lastSn << endl;
 
@@ -306,13 +304,15 @@ void AmTxQueue::moveTxWindow(const int seqNum)
 
     for (int i = 0; i < pos; ++i)
     {
-        if (pduRtxQueue_.get(i) != NULL)
+        unsigned int slot = txSlot(i + txWindowDesc_.firstSeqNum_);
+        if (pduRtxQueue_[slot] != NULL)
         {
             EV << NOW << " AmTxQueue::moveTxWindow deleting PDU ["
                << i + txWindowDesc_.firstSeqNum_
                << "] corresponding index " << i << endl;
 
-            pdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.remove(i));
+            pdu = pduRtxQueue_[slot];
+            pduRtxQueue_[slot] = NULL;
             delete pdu;
             // Stop the rtx timer event
             if (pduTimer_.busy(i + txWindowDesc_.firstSeqNum_))
@@ -322,65 +322,15 @@ void AmTxQueue::moveTxWindow(const int seqNum)
                    << i + txWindowDesc_.firstSeqNum_
                    << "] corresponding index " << i << endl;
             }
-            received_.at(i)=false;
-            discarded_.at(i)=false;
         }
         else
         throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered empty PDU at location %d, shift position %d", i, pos);
     }
 
-    for (int i = pos;
-        i < ((txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_)); ++i)
-    {
-        if (pduRtxQueue_.get(i) != NULL)
-        {
-            pdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.remove(i));
-            pduRtxQueue_.addAt(i - pos, pdu);
-
-            EV << NOW << " AmTxQueue::moveTxWindow  PDU ["
-               << i + txWindowDesc_.firstSeqNum_
-               << "] corresponding index " << i
-               << " being moved at position " << i - pos << endl;
-        }
-        else
-        {
-            throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered empty PDU at location %d, shift position %d", i, pos);
-        }
-
-        EV << NOW << " AmTxQueue::moveTxWindow  PDU ["
-           << i + txWindowDesc_.firstSeqNum_
-           << "] corresponding new index " << i - pos
-           << " marked as received [" << (received_.at(i - pos))
-           << "] , discarded [" << (discarded_.at(i - pos)) << "]" << endl;
-
-        received_.at(i - pos) = received_.at(i);
-        discarded_.at(i - pos) = discarded_.at(i);
-
-        received_.at(i) = false;
-        discarded_.at(i) = false;
-
-        EV << NOW << " AmTxQueue::moveTxWindow  location [" << i
-           << "] corresponding new PDU "
-           << i + pos + txWindowDesc_.firstSeqNum_
-           << " marked as received [" << (received_.at(i))
-           << "] , discarded [" << (discarded_.at(i)) << "]" << endl;
-    }
-
-            // cleanup
-    for (int i = (txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_);
-        i < txWindowDesc_.windowSize_; ++i)
-    {
-        if (pduRtxQueue_.get(i) != NULL)
-            throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered busy PDU at location %d, shift position %d", i,
-                pos);
-
-        EV << NOW << " AmTxQueue::moveTxWindow  empty location [" << i
-           << "] marked as received [" << (received_.at(i))
-           << "] , discarded [" << (discarded_.at(i)) << "]" << endl;
-
-        received_.at(i) = false;
-        discarded_.at(i) = false;
-    }
+    // PDUs after the shift position stay in their slots: only the status
+    // variables have to be realigned with the new window start
+    received_.shiftDown(pos);
+    discarded_.shiftDown(pos);
 
     txWindowDesc_.firstSeqNum_ += pos;
 
@@ -421,7 +371,7 @@ void AmTxQueue::sendMrw(const int seqNum)
     LteRlcAmPdu * pduCopy = pdu->dup();
     pduCopy->setControlInfo(lteInfo->dup());
     //  save copy for retransmission
-    mrwRtxQueue_.addAt(mrwDesc_.mrwSeqNum_, pduCopy);
+    unackedMrw_[mrwDesc_.mrwSeqNum_] = pduCopy;
     // update MRW descriptor
     mrwDesc_.lastMrw_ = mrwDesc_.mrwSeqNum_;
     // Start a timer for MRW message
@@ -472,13 +422,7 @@ void AmTxQueue::handleControlPacket(cPacket* pkt)
                    << " AmTxQueue::handleControlPacket , received BITMAP ACK of size "
                    << bSize << endl;
 
-                for (int i = 0; i < bSize; ++i)
-                {
-                    if (pdu->getBitmap(i))
-                    {
-                        recvAck(pdu->getFirstSn() + i);
-                    }
-                }
+                recvBitmapAck(pdu->getFirstSn(), pdu->getBitmapVec());
             }
 
             break;
@@ -488,49 +432,74 @@ void AmTxQueue::handleControlPacket(cPacket* pkt)
         delete pdu;
     }
 
-void AmTxQueue::recvAck(const int seqNum)
+void AmTxQueue::recvBitmapAck(const int firstSn, const std::vector<bool>& bitmap)
 {
-    int index = seqNum - txWindowDesc_.firstSeqNum_;
+    int base = firstSn - txWindowDesc_.firstSeqNum_;
+    int from = txWindowDesc_.windowSize_;
+    int to = 0;
 
-    EV << NOW << " AmTxBuffer::recvAck ACK received for sequence number "
-       << seqNum << " first sequence n. [" << txWindowDesc_.firstSeqNum_
-       << "] index [" << index << "] " << endl;
-
-    if (index < 0)
+    for (unsigned int i = 0; i < bitmap.size(); ++i)
     {
-        EV << NOW
-           << " AmTxBuffer::recvAck ACK already received - ignoring : index "
-           << index << " first sequence number"
-           << txWindowDesc_.firstSeqNum_ << endl;
+        if (!bitmap[i])
+            continue;
 
-        return;
+        int index = base + i;
+        if (index < 0)
+        {
+            EV << NOW
+               << " AmTxBuffer::recvBitmapAck ACK already received - ignoring : index "
+               << index << " first sequence number"
+               << txWindowDesc_.firstSeqNum_ << endl;
+            continue;
+        }
+
+        if (index >= (int) txWindowDesc_.windowSize_)
+            throw cRuntimeError("AmTxBuffer::recvBitmapAck(): ACK greater than window size %d", txWindowDesc_.windowSize_);
+
+        acked_.set(index);
+        if (index < from)
+            from = index;
+        to = index + 1;
     }
 
-    if (index >= txWindowDesc_.windowSize_)
-        throw cRuntimeError("AmTxBuffer::recvAck(): ACK greater than window size %d", txWindowDesc_.windowSize_);
+    if (from < to)
+        applyAck(from, to);
+}
 
-    if (!(received_.at(index)))
+void AmTxQueue::applyAck(unsigned int from, unsigned int to)
+{
+    for (unsigned int w = from / AM_BITMAP_WORD_BITS; w * AM_BITMAP_WORD_BITS < to; ++w)
     {
-        EV << NOW << " AmTxBuffer::recvAck canceling timer for PDU "
-           << (index + txWindowDesc_.firstSeqNum_) << " index " << index << endl;
-        // Stop the timer
-        if (pduTimer_.busy(index + txWindowDesc_.firstSeqNum_))
-        pduTimer_.remove(index + txWindowDesc_.firstSeqNum_);
+        uint64_t acked = acked_.getWord(w) & AmStatusBitmap::rangeMask(w, from, to);
+        uint64_t received = received_.getWord(w);
+
+        // stop the timers of newly acknowledged PDUs only
+        for (uint64_t newAcks = acked & ~received; newAcks != 0; newAcks &= newAcks - 1)
+        {
+            unsigned int index = w * AM_BITMAP_WORD_BITS + lowestSetBit(newAcks);
+
+            EV << NOW << " AmTxBuffer::applyAck canceling timer for PDU "
+               << (index + txWindowDesc_.firstSeqNum_) << " index " << index << endl;
+
+            if (pduTimer_.busy(index + txWindowDesc_.firstSeqNum_))
+                pduTimer_.remove(index + txWindowDesc_.firstSeqNum_);
+        }
         // Received status variable is set at true after the
-        received_.at(index) = true;
+        received_.setWord(w, received | acked);
     }
+    acked_.clear(from, to);
 }
 
 void AmTxQueue::recvCumulativeAck(const int seqNum)
 {
     // Mark the AM PDUs as received and shift the window
-    if ((seqNum < txWindowDesc_.firstSeqNum_) || (seqNum < 0))
+    if ((seqNum < (int) txWindowDesc_.firstSeqNum_) || (seqNum < 0))
     {
         // Ignore the cumulative ACK, is out of the transmitter window (the MRW command has not yet been received by AM rx entity)
         return;
     }
     else if ((unsigned int) seqNum
-        > (txWindowDesc_.firstSeqNum_ + txWindowDesc_.windowSize_))
+        >= (txWindowDesc_.firstSeqNum_ + txWindowDesc_.windowSize_))
     {
         throw cRuntimeError("AmTxQueue::recvCumulativeAck(): SN %d exceeds window size %d",
             seqNum, txWindowDesc_.windowSize_);
@@ -538,30 +507,16 @@ void AmTxQueue::recvCumulativeAck(const int seqNum)
     else
     {
         // The ACK is inside the window
+        unsigned int to = seqNum - txWindowDesc_.firstSeqNum_ + 1;
+
+        EV << NOW
+           << " AmTxBuffer::recvCumulativeAck ACK received for sequence numbers "
+           << txWindowDesc_.firstSeqNum_ << " to " << seqNum << endl;
+
+        for (unsigned int w = 0; w * AM_BITMAP_WORD_BITS < to; ++w)
+            acked_.setWord(w, acked_.getWord(w) | AmStatusBitmap::rangeMask(w, 0, to));
+        applyAck(0, to);
 
-        for (int i = 0; i <= (seqNum - txWindowDesc_.firstSeqNum_); ++i)
-        {
-            EV << NOW
-               << " AmTxBuffer::recvCumulativeAck ACK received for sequence number "
-               << (i + txWindowDesc_.firstSeqNum_)
-               << " first sequence n. [" << txWindowDesc_.firstSeqNum_
-               << "] "
-            "index [" << i << "] " << endl;
-
-            // the ACK could have already been received
-            if (!(received_.at(i)))
-            {
-                // canceling timer for PDU
-                EV << NOW
-                   << " AmTxBuffer::recvCumulativeAck canceling timer for PDU "
-                   << (i + txWindowDesc_.firstSeqNum_) << " index " << i << endl;
-                // Stop the timer
-                if (pduTimer_.busy(i + txWindowDesc_.firstSeqNum_))
-                pduTimer_.remove(i + txWindowDesc_.firstSeqNum_);
-                // Received status variable is set at true after the
-                received_.at(i) = true;
-            }
-        }
         checkForMrw();
     }
 }
@@ -570,15 +525,16 @@ void AmTxQueue::recvMrwAck(const int seqNum)
 {
     EV << NOW << " AmTxQueue::recvMrwAck for MRW command number " << seqNum << endl;
 
-    if (mrwRtxQueue_.get(seqNum) == NULL)
+    std::map<int, LteRlcAmPdu*>::iterator it = unackedMrw_.find(seqNum);
+    if (it == unackedMrw_.end())
     {
         // The message is related to a MRW which has been discarded by the handle function because it was obsolete.
         return;
     }
 
     // Remove the MRW PDU from the retransmission buffer
-    LteRlcAmPdu* mrwPdu = check_and_cast<LteRlcAmPdu*>(
-        mrwRtxQueue_.remove(seqNum));
+    LteRlcAmPdu* mrwPdu = it->second;
+    unackedMrw_.erase(it);
 
     // Stop the related timer
     if (mrwTimer_.busy(seqNum))
@@ -611,16 +567,17 @@ void AmTxQueue::pduTimerHandle(const int sn)
             "AmTxQueue::pduTimerHandle(): The PDU [%d] for which timer elapsed is out of the window : index [%d]", sn,
             index);
 
-    if (pduRtxQueue_.get(index) == NULL)
+    unsigned int slot = txSlot(sn);
+    if (pduRtxQueue_[slot] == NULL)
         throw cRuntimeError("AmTxQueue::pduTimerHandle(): PDU %d not found", index);
 
     // Check if the PDU has been correctly received, if so the
     // timer should have been previously stopped.
-    if (received_.at(index) == true)
+    if (received_.test(index) == true)
         throw cRuntimeError(" AmTxQueue::pduTimerHandle(): The PDU %d [index %d] has been already received", sn, index);
 
     // Get the PDU information
-    LteRlcAmPdu* pdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.get(index));
+    LteRlcAmPdu* pdu = pduRtxQueue_[slot];
 
     int nextTxNumber = pdu->getTxNumber() + 1;
 
@@ -635,8 +592,6 @@ void AmTxQueue::pduTimerHandle(const int sn)
     else
     {
         EV << NOW << " AmTxQueue::pduTimerHandle starting new transmission" << endl;
-        // extract PDU from buffer
-        pdu = check_and_cast<LteRlcAmPdu*>(pduRtxQueue_.remove(index));
         // A new transmission can be started
         pdu->setTxNumber(nextTxNumber);
         // The RLC PDU is added to the retransmission buffer
@@ -644,7 +599,7 @@ void AmTxQueue::pduTimerHandle(const int sn)
         // .. with control info also!
         copy->setControlInfo(pdu->getControlInfo()->dup());
 
-        pduRtxQueue_.add(copy);
+        pduRtxQueue_[slot] = copy;
         // Reschedule the timer
         pduTimer_.add(pduRtxTimeout_, sn);
         // send down the PDU
@@ -658,7 +613,8 @@ void AmTxQueue::mrwTimerHandle(const int sn)
 
     mrwTimer_.handle(sn);
 
-    if (mrwRtxQueue_.get(sn) == NULL)
+    std::map<int, LteRlcAmPdu*>::iterator it = unackedMrw_.find(sn);
+    if (it == unackedMrw_.end())
         throw cRuntimeError("MRW handler: MRW of SN %d not found in MRW message queue", sn);
 
     // Check if a newer message has been sent
@@ -668,19 +624,19 @@ void AmTxQueue::mrwTimerHandle(const int sn)
 
         // A newer message has been sent
         // Delete the RLC  PDU
-        delete (mrwRtxQueue_.remove(sn));
+        delete it->second;
+        unackedMrw_.erase(it);
     }
     else
     {
         EV << NOW << "AmTxBuffer::mrwTimerHandle retransmitting MRW" << endl;
 
-        LteRlcAmPdu* pdu = check_and_cast<LteRlcAmPdu*>(
-            mrwRtxQueue_.remove(sn));
+        LteRlcAmPdu* pdu = it->second;
         // Retransmit the MRW message
         LteRlcAmPdu* pduCopy = pdu->dup();
         pduCopy->setControlInfo(pdu->getControlInfo()->dup());
         // Enqueue the PDU into the retransmission buffer
-        mrwRtxQueue_.addAt(sn, pduCopy);
+        it->second = pduCopy;
         // Retransmit the MRW control message
         mrwTimer_.add(ctrlPduRtxTimeout_, sn);
         sendPdu(pdu);
@@ -17,6 +17,7 @@
 #include "stack/rlc/am/packet/LteRlcAmSdu_m.h"
 #include "stack/pdcp_rrc/packet/LtePdcpPdu_m.h"
 #include "common/LteControlInfo.h"
+#include "stack/rlc/am/buffer/AmStatusBitmap.h"
 
 /*
  * RLC AM Mode Transmission Entity
@@ -60,21 +61,22 @@ class AmTxQueue : public cSimpleModule
 
     /*
      * The PDU (fragments) buffer.
+     * Circular buffer holding a copy of each PDU in the transmission window,
+     * indexed by sequence number modulo the window size (see txSlot()).
+     * Empty slots are NULL.
      */
-    cArray pduRtxQueue_;
-
-    /*
-     * The MRW PDU retransmission buffer.
-     */
-    cArray mrwRtxQueue_;
+    std::vector<LteRlcAmPdu*> pduRtxQueue_;
 
     //----------------------------------------------------------------------------------------
 
-    // Received status variable
-    std::vector<bool> received_;
+    // Received status variable, indexed by position in the transmission window
+    AmStatusBitmap received_;
 
-    // Discarded status variable
-    std::vector<bool> discarded_;
+    // Discarded status variable, indexed by position in the transmission window
+    AmStatusBitmap discarded_;
+
+    // Positions acknowledged by the status report being processed
+    AmStatusBitmap acked_;
 
     // Transmission window descriptor
     RlcWindowDesc txWindowDesc_;
@@ -108,7 +110,7 @@ class AmTxQueue : public cSimpleModule
 
     //-------------------------------------------------------------------------
 
-    // map of RLC Control PDU that are waiting for ACK
+    // map of RLC Control PDU that are waiting for ACK (MRW retransmission buffer)
     std::map<int, LteRlcAmPdu *> unackedMrw_;
 
   public:
@@ -144,6 +146,15 @@ class AmTxQueue : public cSimpleModule
      */
     virtual void handleMessage(cMessage* msg);
 
+    /* Returns the slot of pduRtxQueue_ holding the given sequence number
+     *
+     * @param seqNum
+     */
+    unsigned int txSlot(unsigned int seqNum) const
+    {
+        return seqNum % txWindowDesc_.windowSize_;
+    }
+
     /* Discards a given RLC PDU and all the PDUs related to the same SDU
      *
      * @param seqNum the sequence number of the PDU that triggers discarding
@@ -178,11 +189,20 @@ class AmTxQueue : public cSimpleModule
      */
     void recvCumulativeAck(const int seqNum);
 
-    /* Receive an ACK from the transmitter ACK entity
+    /* Receive a bitmap ACK from the transmitter ACK entity
      *
-     * @param seqNum
+     * @param firstSn sequence number of the first bitmap entry
+     * @param bitmap received status of the PDUs starting from firstSn
+     */
+    void recvBitmapAck(const int firstSn, const std::vector<bool>& bitmap);
+
+    /* Marks as received the positions set in acked_ within [from, to),
+     * stopping the timers of the PDUs that were not received yet
+     *
+     * @param from first window position (included)
+     * @param to last window position (excluded)
      */
-    void recvAck(const int seqNum);
+    void applyAck(unsigned int from, unsigned int to);
 
     /* Receive a MRW from the AM Receiver
      *
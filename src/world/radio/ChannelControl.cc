@@ -27,7 +27,7 @@ Define_Module(ChannelControl);
 std::ostream& operator<<(std::ostream& os, const ChannelControl::RadioEntry& radio)
 {
     os << radio.radioModule->getFullPath() << " (x=" << radio.pos.x << ",y=" << radio.pos.y << "), "
-       << radio.neighbors.size() << " neighbor(s)";
+       << radio.neighborList.size() << " neighbor(s)";
     return os;
 }
 
@@ -120,7 +120,8 @@ ChannelControl::RadioRef ChannelControl::registerRadio(cModule *radio, cGate *ra
     RadioEntry re;
     re.radioModule = radio;
     re.radioInGate = radioInGate->getPathStartGate();
-    re.isNeighborListValid = false;
+    re.hasPosition = false;
+    re.cellX = re.cellY = 0;
     re.channel = 0;  // for now
     re.isActive = true;
     radios.push_back(re);
@@ -135,13 +136,18 @@ void ChannelControl::unregisterRadio(RadioRef r)
         if (it->radioModule == r->radioModule)
         {
             RadioRef radioToRemove = &*it;
-            // erase radio from all registered radios' neighbor list
-            for (RadioList::iterator i2 = radios.begin(); i2 != radios.end(); ++i2)
+            // erase radio from its neighbors' neighbor list (connections are symmetric)
+            for (unsigned int i = 0; i < radioToRemove->neighborList.size(); i++)
+                removeNeighbor(radioToRemove->neighborList[i], radioToRemove);
+
+            // erase radio from the grid
+            if (radioToRemove->hasPosition)
             {
-                RadioRef otherRadio = &*i2;
-                otherRadio->neighbors.erase(radioToRemove);
-                otherRadio->isNeighborListValid = false;
-                radioToRemove->isNeighborListValid = false;
+                Grid::iterator cell = grid.find(GridCell(radioToRemove->cellX, radioToRemove->cellY));
+                RadioRefVector& cellRadios = cell->second;
+                cellRadios.erase(std::find(cellRadios.begin(), cellRadios.end(), radioToRemove));
+                if (cellRadios.empty())
+                    grid.erase(cell);
             }
 
             // erase radio from registered radios
@@ -165,46 +171,93 @@ ChannelControl::RadioRef ChannelControl::lookupRadio(cModule *radio)
 const ChannelControl::RadioRefVector& ChannelControl::getNeighbors(RadioRef h)
 {
     Enter_Method_Silent();
-    if (!h->isNeighborListValid)
+    return h->neighborList;
+}
+
+bool ChannelControl::addNeighbor(RadioRef h, RadioRef r)
+{
+    RadioRefVector::iterator it = std::lower_bound(h->neighborList.begin(), h->neighborList.end(), r, RadioEntry::Compare());
+    if (it != h->neighborList.end() && *it == r)
+        return false;
+    h->neighborList.insert(it, r);
+    return true;
+}
+
+bool ChannelControl::removeNeighbor(RadioRef h, RadioRef r)
+{
+    RadioRefVector::iterator it = std::lower_bound(h->neighborList.begin(), h->neighborList.end(), r, RadioEntry::Compare());
+    if (it == h->neighborList.end() || *it != r)
+        return false;
+    h->neighborList.erase(it);
+    return true;
+}
+
+ChannelControl::GridCell ChannelControl::getGridCell(const inet::Coord& pos) const
+{
+    // with no finite interference distance, all the radios are in the same cell
+    if (!(maxInterferenceDistance > 0) || maxInterferenceDistance >= HUGE_VAL)
+        return GridCell(0, 0);
+    return GridCell((int) floor(pos.x / maxInterferenceDistance), (int) floor(pos.y / maxInterferenceDistance));
+}
+
+void ChannelControl::updateGridCell(RadioRef h)
+{
+    GridCell newCell = getGridCell(h->pos);
+    if (h->hasPosition)
     {
-        h->neighborList.clear();
-        for (std::set<RadioRef,RadioEntry::Compare>::iterator it = h->neighbors.begin(); it != h->neighbors.end(); it++)
-            h->neighborList.push_back(*it);
-        h->isNeighborListValid = true;
+        GridCell oldCell(h->cellX, h->cellY);
+        if (oldCell == newCell)
+            return;
+
+        Grid::iterator cell = grid.find(oldCell);
+        RadioRefVector& cellRadios = cell->second;
+        cellRadios.erase(std::find(cellRadios.begin(), cellRadios.end(), h));
+        if (cellRadios.empty())
+            grid.erase(cell);
     }
-    return h->neighborList;
+    grid[newCell].push_back(h);
+    h->cellX = newCell.first;
+    h->cellY = newCell.second;
+    h->hasPosition = true;
 }
 
 void ChannelControl::updateConnections(RadioRef h)
 {
     inet::Coord& hpos = h->pos;
     double maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
-    for (RadioList::iterator it = radios.begin(); it != radios.end(); ++it)
-    {
-        RadioEntry *hi = &(*it);
-        if (hi == h)
-            continue;
 
-        // get the distance between the two radios.
+    // out of range: disconnect. Only current neighbors can be disconnected
+    for (unsigned int i = 0; i < h->neighborList.size();)
+    {
+        RadioRef hi = h->neighborList[i];
         // (omitting the square root (calling sqrdist() instead of distance()) saves about 5% CPU)
-        bool inRange = hpos.sqrdist(hi->pos) < maxDistSquared;
-
-        if (inRange)
+        if (hpos.sqrdist(hi->pos) < maxDistSquared)
         {
-            // nodes within communication range: connect
-            if (h->neighbors.insert(hi).second == true)
-            {
-                hi->neighbors.insert(h);
-                h->isNeighborListValid = hi->isNeighborListValid = false;
-            }
+            i++;
+            continue;
         }
-        else
+        h->neighborList.erase(h->neighborList.begin() + i);
+        removeNeighbor(hi, h);
+    }
+
+    // nodes within communication range: connect. Only radios in the surrounding cells can be in range
+    for (int x = h->cellX - 1; x <= h->cellX + 1; x++)
+    {
+        for (int y = h->cellY - 1; y <= h->cellY + 1; y++)
         {
-            // out of range: disconnect
-            if (h->neighbors.erase(hi))
+            Grid::iterator cell = grid.find(GridCell(x, y));
+            if (cell == grid.end())
+                continue;
+
+            RadioRefVector& cellRadios = cell->second;
+            for (unsigned int i = 0; i < cellRadios.size(); i++)
             {
-                hi->neighbors.erase(h);
-                h->isNeighborListValid = hi->isNeighborListValid = false;
+                RadioRef hi = cellRadios[i];
+                if (hi == h)
+                    continue;
+
+                if (hpos.sqrdist(hi->pos) < maxDistSquared && addNeighbor(h, hi))
+                    addNeighbor(hi, h);
             }
         }
     }
@@ -220,6 +273,7 @@ void ChannelControl::setRadioPosition(RadioRef r, const inet::Coord& pos)
 {
     Enter_Method_Silent();
     r->pos = pos;
+    updateGridCell(r);
     updateConnections(r);
 }
 
@@ -19,7 +19,8 @@
 
 #include <vector>
 #include <list>
-#include <set>
+#include <map>
+#include <algorithm>
 
 #include "inet/common/INETDefs.h"
 #include "inet/common/geometry/common/Coord.h"
@@ -32,7 +33,7 @@ class AirFrame;
 
 /**
  * Keeps track of radios/NICs, their positions and channels;
- * also caches neighbor info (which other Radios are within
+ * also keeps neighbor info (which other Radios are within
  * interference distance).
  */
 struct IChannelControl::RadioEntry {
@@ -40,6 +41,8 @@ struct IChannelControl::RadioEntry {
     cGate *radioInGate;  // gate on host module used to receive airframes
     int channel;
     inet::Coord pos; // cached radio position
+    bool hasPosition; // false until the first position update
+    int cellX, cellY; // grid cell containing pos
 
     struct Compare {
         bool operator() (const RadioRef &lhs, const RadioRef &rhs) const {
@@ -47,11 +50,9 @@ struct IChannelControl::RadioEntry {
             return lhs->radioModule->getId() < rhs->radioModule->getId();
         }
     };
-    // we cache neighbors set in an std::vector, because std::set iteration is slow;
-    // std::vector is created and updated on demand
-    std::set<RadioRef, Compare> neighbors; // cached neighbor list
+    // radios within interference distance, sorted by module id (see Compare);
+    // updated incrementally on connection changes
     std::vector<RadioRef> neighborList;
-    bool isNeighborListValid;
     bool isActive;
 };
 
@@ -63,12 +64,21 @@ struct IChannelControl::RadioEntry {
  */
 class ChannelControl : public cSimpleModule, public IChannelControl
 {
+  public:
+    typedef std::vector<RadioRef> RadioRefVector;
+
   protected:
     typedef std::list<RadioEntry> RadioList;
-    typedef std::vector<RadioRef> RadioRefVector;
 
     RadioList radios;
 
+    /** uniform grid of square cells with side maxInterferenceDistance: a radio can only
+     * be in range of the radios in its own cell and in the 8 surrounding ones
+     */
+    typedef std::pair<int, int> GridCell;
+    typedef std::map<GridCell, RadioRefVector> Grid;
+    Grid grid;
+
     /** keeps track of ongoing transmissions; this is needed when a radio
      * switches to another channel (then it needs to know whether the target channel
      * is empty or busy)
@@ -94,6 +104,18 @@ class ChannelControl : public cSimpleModule, public IChannelControl
   protected:
     virtual void updateConnections(RadioRef h);
 
+    /** Computes the grid cell containing the given position */
+    virtual GridCell getGridCell(const inet::Coord& pos) const;
+
+    /** Moves the radio to the grid cell containing its current position */
+    virtual void updateGridCell(RadioRef h);
+
+    /** Adds r to the (sorted) neighbor list of h, returns false if already there */
+    static bool addNeighbor(RadioRef h, RadioRef r);
+
+    /** Removes r from the neighbor list of h, returns false if it was not there */
+    static bool removeNeighbor(RadioRef h, RadioRef r);
+
     /** Calculate interference distance*/
     virtual double calcInterfDist();
 
@@ -106,9 +128,6 @@ class ChannelControl : public cSimpleModule, public IChannelControl
     /** Validate the channel identifier */
     virtual void checkChannel(int channel);
 
-    /** Get the list of modules in range of the given host */
-    virtual const RadioRefVector& getNeighbors(RadioRef h);
-
     /** Notifies the channel control with an ongoing transmission */
     virtual void addOngoingTransmission(RadioRef h, AirFrame *frame);
 
@@ -125,6 +144,9 @@ class ChannelControl : public cSimpleModule, public IChannelControl
     /** Unregisters the given radio */
     virtual void unregisterRadio(RadioRef r);
 
+    /** Get the list of modules in range of the given host */
+    virtual const RadioRefVector& getNeighbors(RadioRef h);
+
     /** Returns the host module that contains the given radio */
     virtual cModule *getRadioModule(RadioRef r) const { return r->radioModule; }
 
@@ -29,6 +29,10 @@ void LteX2Manager::initialize(int stage)
     {
         // get the node id
         nodeId_ = getAncestorPar("macCellId");
+
+        idealX2_ = par("idealX2");
+        idealX2Delay_ = par("idealX2Delay");
+        idealX2Datarate_ = par("idealX2Datarate");
     }
     else if (stage == inet::INITSTAGE_NETWORK_LAYER_3)
     {
@@ -125,6 +129,12 @@ void LteX2Manager::fromStack(cPacket* pkt)
             x2msg->setSourceId(nodeId_);
             x2msg->setDestinationId(targetEnb);
 
+            if (idealX2_)
+            {
+                sendIdealX2(x2msg, targetEnb);
+                continue;
+            }
+
             // send to the gate connected to the GTPUser module
             cGate* outputGate = gate("x2Gtp$o");
             send(x2msg, outputGate);
@@ -142,6 +152,12 @@ void LteX2Manager::fromStack(cPacket* pkt)
             x2msg_dup->setSourceId(nodeId_);
             x2msg_dup->setDestinationId(*it);
 
+            if (idealX2_)
+            {
+                sendIdealX2(x2msg_dup, *it);
+                continue;
+            }
+
             // select the index for the output gate (it belongs to a vector)
             int gateIndex = x2InterfaceTable_[*it];
             cGate* outputGate = gate("x2$o",gateIndex);
@@ -172,3 +188,35 @@ void LteX2Manager::fromX2(cPacket* pkt)
     EV << "LteX2Manager::fromX2 - send X2MSG to LTE stack" << endl;
     send(PK(x2msg), outGate);
 }
+
+void LteX2Manager::sendIdealX2(LteX2Message* x2msg, X2NodeId destId)
+{
+    // the same peers as with the X2Apps can be reached
+    if (x2InterfaceTable_.find(destId) == x2InterfaceTable_.end())
+        throw cRuntimeError("LteX2Manager::sendIdealX2 - no X2 connection towards node %d", destId);
+
+    std::map<X2NodeId, cGate*>::iterator pit = idealX2Peers_.find(destId);
+    if (pit == idealX2Peers_.end())
+    {
+        cModule* peer = getBinder()->getX2ManagerFromMacNodeId(destId);
+        if (peer == NULL)
+            throw cRuntimeError("LteX2Manager::sendIdealX2 - cannot find the X2 manager of node %d", destId);
+        pit = idealX2Peers_.insert(std::pair<X2NodeId, cGate*>(destId, peer->gate("idealX2In"))).first;
+    }
+
+    // messages towards the same peer are serialized on the link
+    simtime_t start = NOW;
+    simtime_t duration = 0;
+    if (idealX2Datarate_ > 0)
+    {
+        simtime_t& busyUntil = idealX2BusyUntil_[destId];
+        if (busyUntil > start)
+            start = busyUntil;
+        // LteX2Message::getBitLength() counts the encapsulated (or batched) datagrams, not only the IEs
+        duration = x2msg->getBitLength() / idealX2Datarate_;
+        busyUntil = start + duration;
+    }
+
+    EV << "LteX2Manager::sendIdealX2 - send X2MSG to node " << destId << " at " << start << endl;
+    sendDirect(x2msg, start - NOW + idealX2Delay_, duration, pit->second);
+}
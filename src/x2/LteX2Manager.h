@@ -32,6 +32,19 @@ class LteX2Manager : public cSimpleModule {
     // where the X2AP for that destination is connected to
     std::map<X2NodeId, int> x2InterfaceTable_;
 
+    /*
+     * Ideal X2
+     */
+    bool idealX2_;
+    simtime_t idealX2Delay_;
+    double idealX2Datarate_;   // 0 means infinite
+
+    // for each destination ID, the direct input gate of its LteX2Manager (resolved on first use)
+    std::map<X2NodeId, cGate*> idealX2Peers_;
+
+    // for each destination ID, the time when the last message sent on the ideal link ends
+    std::map<X2NodeId, simtime_t> idealX2BusyUntil_;
+
 protected:
 
     void initialize(int stage);
@@ -41,6 +54,9 @@ protected:
     virtual void fromStack(cPacket* pkt);
     virtual void fromX2(cPacket* pkt);
 
+    // delivers the message to the LteX2Manager of the destination eNB (ideal X2)
+    virtual void sendIdealX2(LteX2Message* x2msg, X2NodeId destId);
+
 public:
     LteX2Manager();
     virtual ~LteX2Manager();
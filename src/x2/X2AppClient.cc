@@ -10,7 +10,6 @@
 
 #include "x2/X2AppClient.h"
 #include "corenetwork/binder/LteBinder.h"
-#include "stack/mac/layer/LteMacEnb.h"
 #include "inet/networklayer/common/L3AddressResolver.h"
 #include "inet/transportlayer/sctp/SCTPAssociation.h"
 #include "inet/transportlayer/contract/sctp/SCTPCommand_m.h"
@@ -33,7 +32,7 @@ void X2AppClient::initialize(int stage)
         L3Address addr = L3AddressResolver().resolve(par("connectAddress").stringValue());
         X2NodeId peerId = getBinder()->getX2NodeId(addr.toIPv4());
 
-        X2NodeId nodeId = check_and_cast<LteMacEnb*>(getParentModule()->getParentModule()->getSubmodule("lteNic")->getSubmodule("mac"))->getMacCellId();
+        X2NodeId nodeId = getAncestorPar("macCellId");
         getBinder()->setX2PeerAddress(nodeId, peerId, addr);
 
         // set the connect port
@@ -44,6 +44,16 @@ class LteX2Message : public LteX2Message_Base
     /// Size of the X2 message
     int64_t msgLength_;
 
+    /// deletes the IEs that have not been popped
+    void clearIes()
+    {
+        while(!ieList_.empty())
+        {
+            delete ieList_.front();
+            ieList_.pop_front();
+        }
+    }
+
   public:
 
     /**
@@ -59,8 +69,8 @@ class LteX2Message : public LteX2Message_Base
 
     /*
      * Copy constructors
-     * FIXME Copy constructors do not preserve ownership
-     * Here I should iterate on the list and set all ownerships
+     * The IEs are duplicated, so that each copy of a message (e.g. one for each
+     * destination of a multicast X2 message) has its own IEs
      */
     LteX2Message(const LteX2Message& other) :
         LteX2Message_Base()
@@ -74,7 +84,10 @@ class LteX2Message : public LteX2Message_Base
             return *this;
         LteX2Message_Base::operator=(other);
         type_ = other.type_;
-        ieList_ = other.ieList_;
+        clearIes();
+        X2InformationElementsList::const_iterator it = other.ieList_.begin();
+        for (; it != other.ieList_.end(); ++it)
+            ieList_.push_back((*it)->dup());
         msgLength_ = other.msgLength_;
         return *this;
     }
@@ -86,10 +99,7 @@ class LteX2Message : public LteX2Message_Base
 
     virtual ~LteX2Message()
     {
-        while(!ieList_.empty())
-        {
-            ieList_.pop_front();
-        }
+        clearIes();
     }
 
     // getter/setter methods for the type field
@@ -133,14 +143,15 @@ class LteX2Message : public LteX2Message_Base
         return (!ieList_.empty());
     }
 
+    /// length of the IEs plus the length of the encapsulated (or batched) packets
     int64_t getByteLength() const
     {
-        return msgLength_;
+        return msgLength_ + LteX2Message_Base::getByteLength();
     }
 
     int64_t getBitLength() const
     {
-        return (getByteLength() * 8);
+        return msgLength_ * 8 + LteX2Message_Base::getBitLength();
     }
 };
 